@@ -0,0 +1,123 @@
+/***********************************************************
+* Filename:                     benchArrayDeque.c
+*
+* Overview:
+*   Array-backed baseline for the deque benchmarks: a growable
+*   power of two ring of long.
+************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include "dequeBench.h"
+
+// Baseline: growable circular array of long, no links at all
+struct ArrayDeque
+{
+	long* values;
+	int capacity;
+	int start;
+	int size;
+};
+
+static long* slot(struct ArrayDeque* deque, int index)
+{
+	return &deque->values[(deque->start + index) & (deque->capacity - 1)];
+}
+
+static void grow(struct ArrayDeque* deque)
+{
+	long* values = malloc(2 * deque->capacity * sizeof(long));
+	assert(values!=0);
+	for(int i = 0; i < deque->size; i++) values[i] = *slot(deque, i);
+	free(deque->values);
+	deque->values = values;
+	deque->capacity *= 2;
+	deque->start = 0;
+}
+
+static void* create(void)
+{
+	struct ArrayDeque* deque = malloc(sizeof(struct ArrayDeque));
+	assert(deque!=0);
+	deque->capacity = 16;
+	deque->values = malloc(deque->capacity * sizeof(long));
+	assert(deque->values!=0);
+	deque->start = 0;
+	deque->size = 0;
+	return deque;
+}
+
+static void destroy(void* arg)
+{
+	struct ArrayDeque* deque = arg;
+	free(deque->values);
+	free(deque);
+}
+
+static void addFront(void* arg, long value)
+{
+	struct ArrayDeque* deque = arg;
+	if(deque->size == deque->capacity) grow(deque);
+	deque->start = (deque->start - 1) & (deque->capacity - 1);
+	deque->size++;
+	*slot(deque, 0) = value;
+}
+
+static void addBack(void* arg, long value)
+{
+	struct ArrayDeque* deque = arg;
+	if(deque->size == deque->capacity) grow(deque);
+	*slot(deque, deque->size++) = value;
+}
+
+static long front(void* arg) { return *slot(arg, 0); }
+static long back(void* arg) { return *slot(arg, ((struct ArrayDeque*)arg)->size - 1); }
+
+static void removeFront(void* arg)
+{
+	struct ArrayDeque* deque = arg;
+	deque->start = (deque->start + 1) & (deque->capacity - 1);
+	deque->size--;
+}
+
+static void removeBack(void* arg)
+{
+	((struct ArrayDeque*)arg)->size--;
+}
+
+static int contains(void* arg, long value)
+{
+	struct ArrayDeque* deque = arg;
+	for(int i = 0; i < deque->size; i++){
+		if(*slot(deque, i) == value) return 1;
+	}
+	return 0;
+}
+
+static void removeValue(void* arg, long value)
+{
+	struct ArrayDeque* deque = arg;
+	for(int i = 0; i < deque->size; i++){
+		if(*slot(deque, i) == value){
+			// close the gap from the back
+			for(int j = i; j < deque->size - 1; j++) *slot(deque, j) = *slot(deque, j + 1);
+			deque->size--;
+			return;
+		}
+	}
+}
+
+static void reverse(void* arg)
+{
+	struct ArrayDeque* deque = arg;
+	for(int i = 0, j = deque->size - 1; i < j; i++, j--){
+		long temp = *slot(deque, i);
+		*slot(deque, i) = *slot(deque, j);
+		*slot(deque, j) = temp;
+	}
+}
+
+const struct DequeOps arrayDequeOps = {
+	"ArrayDeque", create, destroy, addFront, addBack, front, back,
+	removeFront, removeBack, contains, removeValue, reverse
+};
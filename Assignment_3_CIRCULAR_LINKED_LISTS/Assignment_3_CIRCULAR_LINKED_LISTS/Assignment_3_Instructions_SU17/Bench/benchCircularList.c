@@ -0,0 +1,37 @@
+/***********************************************************
+* Filename:                     benchCircularList.c
+*
+* Overview:
+*   DequeOps adapters for CircularList, plain and pooled. Built
+*   once per backend, CIRCULAR_LIST_NAME tells the rows apart.
+************************************************************/
+
+#include "../CLDeque/circularList.h"
+#include "dequeBench.h"
+
+// Name reported for the backend this file is linked against
+#ifndef CIRCULAR_LIST_NAME
+#define CIRCULAR_LIST_NAME "CircularList"
+#endif
+
+static void* create(void) { return circularListCreate(); }
+static void* createPooled(void) { return circularListCreatePooled(); }
+static void destroy(void* deque) { circularListDestroy(deque); }
+static void addFront(void* deque, long value) { circularListAddFront(deque, (TYPE)value); }
+static void addBack(void* deque, long value) { circularListAddBack(deque, (TYPE)value); }
+static long front(void* deque) { return (long)circularListFront(deque); }
+static long back(void* deque) { return (long)circularListBack(deque); }
+static void removeFront(void* deque) { circularListRemoveFront(deque); }
+static void removeBack(void* deque) { circularListRemoveBack(deque); }
+static int contains(void* deque, long value) { return circularListContains(deque, (TYPE)value); }
+static void reverse(void* deque) { circularListReverse(deque); }
+
+const struct DequeOps circularListOps = {
+	CIRCULAR_LIST_NAME, create, destroy, addFront, addBack, front, back,
+	removeFront, removeBack, contains, 0, reverse
+};
+
+const struct DequeOps circularListPooledOps = {
+	CIRCULAR_LIST_NAME "Pooled", createPooled, destroy, addFront, addBack, front, back,
+	removeFront, removeBack, contains, 0, reverse
+};
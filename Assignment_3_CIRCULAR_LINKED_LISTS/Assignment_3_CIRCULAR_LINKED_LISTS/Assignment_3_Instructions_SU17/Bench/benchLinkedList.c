@@ -0,0 +1,43 @@
+/***********************************************************
+* Filename:                     benchLinkedList.c
+*
+* Overview:
+*   DequeOps adapters for LinkedList: plain, pooled, and with
+*   the hash index enabled for the bag workloads.
+************************************************************/
+
+#include "../LLDeque/linkedList.h"
+#include "dequeBench.h"
+
+static void* create(void) { return linkedListCreate(); }
+static void* createPooled(void) { return linkedListCreatePooled(); }
+static void* createIndexed(void)
+{
+	struct LinkedList* list = linkedListCreate();
+	linkedListEnableIndex(list);
+	return list;
+}
+static void destroy(void* deque) { linkedListDestroy(deque); }
+static void addFront(void* deque, long value) { linkedListAddFront(deque, (TYPE)value); }
+static void addBack(void* deque, long value) { linkedListAddBack(deque, (TYPE)value); }
+static long front(void* deque) { return (long)linkedListFront(deque); }
+static long back(void* deque) { return (long)linkedListBack(deque); }
+static void removeFront(void* deque) { linkedListRemoveFront(deque); }
+static void removeBack(void* deque) { linkedListRemoveBack(deque); }
+static int contains(void* deque, long value) { return linkedListContains(deque, (TYPE)value); }
+static void removeValue(void* deque, long value) { linkedListRemove(deque, (TYPE)value); }
+
+const struct DequeOps linkedListOps = {
+	"LinkedList", create, destroy, addFront, addBack, front, back,
+	removeFront, removeBack, contains, removeValue, 0
+};
+
+const struct DequeOps linkedListPooledOps = {
+	"LinkedListPooled", createPooled, destroy, addFront, addBack, front, back,
+	removeFront, removeBack, contains, removeValue, 0
+};
+
+const struct DequeOps linkedListIndexedOps = {
+	"LinkedListIndexed", createIndexed, destroy, addFront, addBack, front, back,
+	removeFront, removeBack, contains, removeValue, 0
+};
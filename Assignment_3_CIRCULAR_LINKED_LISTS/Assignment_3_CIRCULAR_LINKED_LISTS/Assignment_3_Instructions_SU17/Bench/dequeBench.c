@@ -0,0 +1,319 @@
+/***********************************************************
+* Filename:                     dequeBench.c
+*
+* Overview:
+*   Microbenchmarks for the deques: push and pop at each end,
+*   a mixed random workload, bag contains/remove and reverse,
+*   over a range of sizes. Every structure is driven through a
+*   DequeOps adapter and every run uses the same fixed seed, so
+*   two builds can be compared row by row. Each row is the
+*   median of several repeats; for reverse an operation is one
+*   element moved.
+*
+* Input:
+*   [--json] [--no-header] [--sizes n,n,...] [--repeat r]
+*   [--seed s] [--only structure prefix]
+*
+* Output:
+*   CSV (default) or one JSON object per line on stdout
+************************************************************/
+
+// clock_gettime is POSIX, not C99
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "dequeBench.h"
+
+// Cap on lookups and removes per bag run, the linear bags are O(n) each
+#define BAG_OPERATIONS 2000
+
+// Elements reverse should move per run, small lists reverse many times
+#define REVERSE_ELEMENTS (1L << 20)
+
+#define MAX_SIZES 16
+
+static const struct DequeOps* structures[] = {
+	&arrayDequeOps,
+	&linkedListOps,
+	&linkedListPooledOps,
+	&linkedListIndexedOps,
+	&circularListOps,
+	&circularListPooledOps,
+};
+
+struct Options
+{
+	int json;
+	int header;
+	long sizes[MAX_SIZES];
+	int sizeCount;
+	int repeat;
+	unsigned long seed;
+	const char* only;
+};
+
+static unsigned long state;
+static volatile long sink;
+
+static unsigned long nextRandom()
+{
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+static double now()
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void fill(const struct DequeOps* ops, void* deque, long size)
+{
+	for(long i = 0; i < size; i++) ops->addBack(deque, 2 * i);
+}
+
+/* Each workload builds its own deque, times only the operations being
+   measured, and returns the number of operations it timed. */
+
+static long pushBack(const struct DequeOps* ops, long size, double* seconds)
+{
+	void* deque = ops->create();
+	double start = now();
+	for(long i = 0; i < size; i++) ops->addBack(deque, i);
+	*seconds = now() - start;
+	ops->destroy(deque);
+	return size;
+}
+
+static long pushFront(const struct DequeOps* ops, long size, double* seconds)
+{
+	void* deque = ops->create();
+	double start = now();
+	for(long i = 0; i < size; i++) ops->addFront(deque, i);
+	*seconds = now() - start;
+	ops->destroy(deque);
+	return size;
+}
+
+static long popFront(const struct DequeOps* ops, long size, double* seconds)
+{
+	void* deque = ops->create();
+	fill(ops, deque, size);
+	long sum = 0;
+	double start = now();
+	for(long i = 0; i < size; i++){
+		sum += ops->front(deque);
+		ops->removeFront(deque);
+	}
+	*seconds = now() - start;
+	sink = sum;
+	ops->destroy(deque);
+	return size;
+}
+
+static long popBack(const struct DequeOps* ops, long size, double* seconds)
+{
+	void* deque = ops->create();
+	fill(ops, deque, size);
+	long sum = 0;
+	double start = now();
+	for(long i = 0; i < size; i++){
+		sum += ops->back(deque);
+		ops->removeBack(deque);
+	}
+	*seconds = now() - start;
+	sink = sum;
+	ops->destroy(deque);
+	return size;
+}
+
+static long mixed(const struct DequeOps* ops, long size, double* seconds)
+{
+	void* deque = ops->create();
+	fill(ops, deque, size);
+	long count = size, operations = 4 * size, sum = 0;
+	double start = now();
+	for(long i = 0; i < operations; i++){
+		switch(nextRandom() & 3){
+		case 0: ops->addFront(deque, i); count++; break;
+		case 1: ops->addBack(deque, i); count++; break;
+		case 2:
+			if(count > 0){ sum += ops->front(deque); ops->removeFront(deque); count--; }
+			break;
+		default:
+			if(count > 0){ sum += ops->back(deque); ops->removeBack(deque); count--; }
+			break;
+		}
+	}
+	*seconds = now() - start;
+	sink = sum;
+	ops->destroy(deque);
+	return operations;
+}
+
+static long contains(const struct DequeOps* ops, long size, double* seconds)
+{
+	void* deque = ops->create();
+	fill(ops, deque, size);
+	long lookups = size < BAG_OPERATIONS ? size : BAG_OPERATIONS, found = 0;
+
+	// values are the even numbers below 2 * size, so half the lookups hit
+	double start = now();
+	for(long i = 0; i < lookups; i++){
+		found += ops->contains(deque, (long)(nextRandom() % (2 * size)));
+	}
+	*seconds = now() - start;
+	sink = found;
+	ops->destroy(deque);
+	return lookups;
+}
+
+static long removeValues(const struct DequeOps* ops, long size, double* seconds)
+{
+	void* deque = ops->create();
+	fill(ops, deque, size);
+	long removes = size < BAG_OPERATIONS ? size : BAG_OPERATIONS;
+
+	// distinct values that are all present, in random order
+	long* values = malloc(size * sizeof(long));
+	for(long i = 0; i < size; i++) values[i] = 2 * i;
+	for(long i = 0; i < removes; i++){
+		long j = i + (long)(nextRandom() % (size - i));
+		long temp = values[i];
+		values[i] = values[j];
+		values[j] = temp;
+	}
+
+	double start = now();
+	for(long i = 0; i < removes; i++) ops->remove(deque, values[i]);
+	*seconds = now() - start;
+	free(values);
+	ops->destroy(deque);
+	return removes;
+}
+
+static long reverse(const struct DequeOps* ops, long size, double* seconds)
+{
+	void* deque = ops->create();
+	fill(ops, deque, size);
+	long times = REVERSE_ELEMENTS / size;
+	if(times < 1) times = 1;
+	double start = now();
+	for(long i = 0; i < times; i++) ops->reverse(deque);
+	*seconds = now() - start;
+	sink = ops->front(deque);
+	ops->destroy(deque);
+	return times * size;
+}
+
+struct Workload
+{
+	const char* name;
+	long (*run)(const struct DequeOps* ops, long size, double* seconds);
+	int needsContains;
+	int needsRemove;
+	int needsReverse;
+};
+
+static const struct Workload workloads[] = {
+	{"push_back", pushBack, 0, 0, 0},
+	{"push_front", pushFront, 0, 0, 0},
+	{"pop_front", popFront, 0, 0, 0},
+	{"pop_back", popBack, 0, 0, 0},
+	{"mixed", mixed, 0, 0, 0},
+	{"contains", contains, 1, 0, 0},
+	{"remove", removeValues, 0, 1, 0},
+	{"reverse", reverse, 0, 0, 1},
+};
+
+static int compareSeconds(const void* a, const void* b)
+{
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+static void report(struct Options* options, const char* structure, const char* workload,
+                   long size, long operations, double seconds)
+{
+	double nsPerOp = seconds * 1e9 / operations;
+	double opsPerSec = seconds > 0 ? operations / seconds : 0;
+	if(options->json){
+		printf("{\"structure\": \"%s\", \"workload\": \"%s\", \"size\": %ld, "
+		       "\"operations\": %ld, \"seconds\": %.6f, \"ns_per_op\": %.2f, \"ops_per_sec\": %.0f}\n",
+		       structure, workload, size, operations, seconds, nsPerOp, opsPerSec);
+	}
+	else {
+		printf("%s,%s,%ld,%ld,%.6f,%.2f,%.0f\n", structure, workload, size, operations,
+		       seconds, nsPerOp, opsPerSec);
+	}
+}
+
+static void run(struct Options* options, const struct DequeOps* ops, const struct Workload* workload,
+                long size)
+{
+	double seconds[options->repeat];
+	long operations = 0;
+
+	// the same random stream for every structure and repeat
+	for(int i = 0; i < options->repeat; i++){
+		state = options->seed;
+		operations = workload->run(ops, size, &seconds[i]);
+	}
+	qsort(seconds, options->repeat, sizeof(double), compareSeconds);
+	report(options, ops->name, workload->name, size, operations, seconds[options->repeat / 2]);
+}
+
+static void parseSizes(struct Options* options, char* list)
+{
+	options->sizeCount = 0;
+	for(char* size = strtok(list, ","); size!=0 && options->sizeCount < MAX_SIZES;
+	    size = strtok(0, ",")){
+		long value = atol(size);
+		if(value > 0) options->sizes[options->sizeCount++] = value;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	struct Options options = {0, 1, {100, 1000, 10000, 100000}, 4, 5, 88172645463325252UL, 0};
+
+	for(int i = 1; i < argc; i++){
+		if(strcmp(argv[i], "--json") == 0) options.json = 1;
+		else if(strcmp(argv[i], "--no-header") == 0) options.header = 0;
+		else if(strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) parseSizes(&options, argv[++i]);
+		else if(strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) options.repeat = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc) options.seed = strtoul(argv[++i], 0, 10);
+		else if(strcmp(argv[i], "--only") == 0 && i + 1 < argc) options.only = argv[++i];
+		else {
+			fprintf(stderr, "usage: %s [--json] [--no-header] [--sizes n,n,...] [--repeat r] "
+			        "[--seed s] [--only structure prefix]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(options.repeat < 1) options.repeat = 1;
+	if(options.seed == 0) options.seed = 1;
+
+	if(options.header && !options.json){
+		printf("structure,workload,size,operations,seconds,ns_per_op,ops_per_sec\n");
+	}
+
+	for(size_t s = 0; s < sizeof(structures) / sizeof(structures[0]); s++){
+		const struct DequeOps* ops = structures[s];
+		if(options.only!=0 && strncmp(options.only, ops->name, strlen(options.only)) != 0) continue;
+		for(size_t w = 0; w < sizeof(workloads) / sizeof(workloads[0]); w++){
+			if(workloads[w].needsContains && ops->contains == 0) continue;
+			if(workloads[w].needsRemove && ops->remove == 0) continue;
+			if(workloads[w].needsReverse && ops->reverse == 0) continue;
+			for(int i = 0; i < options.sizeCount; i++){
+				run(&options, ops, &workloads[w], options.sizes[i]);
+			}
+		}
+	}
+	return 0;
+}
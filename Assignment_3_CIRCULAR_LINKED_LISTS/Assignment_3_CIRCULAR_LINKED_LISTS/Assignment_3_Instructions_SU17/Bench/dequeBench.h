@@ -0,0 +1,30 @@
+#ifndef DEQUE_BENCH_H
+#define DEQUE_BENCH_H
+
+// Adapter the benchmark drives, values cross it as long so each
+// structure can keep its own TYPE. Bag and reverse entries may be null
+// when a structure does not offer them.
+struct DequeOps
+{
+	const char* name;
+	void* (*create)(void);
+	void (*destroy)(void* deque);
+	void (*addFront)(void* deque, long value);
+	void (*addBack)(void* deque, long value);
+	long (*front)(void* deque);
+	long (*back)(void* deque);
+	void (*removeFront)(void* deque);
+	void (*removeBack)(void* deque);
+	int (*contains)(void* deque, long value);
+	void (*remove)(void* deque, long value);
+	void (*reverse)(void* deque);
+};
+
+extern const struct DequeOps arrayDequeOps;
+extern const struct DequeOps linkedListOps;
+extern const struct DequeOps linkedListPooledOps;
+extern const struct DequeOps linkedListIndexedOps;
+extern const struct DequeOps circularListOps;
+extern const struct DequeOps circularListPooledOps;
+
+#endif
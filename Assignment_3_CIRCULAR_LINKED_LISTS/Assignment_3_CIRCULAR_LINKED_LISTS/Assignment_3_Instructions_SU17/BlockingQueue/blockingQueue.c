@@ -0,0 +1,389 @@
+/***********************************************************
+* Filename:                     blockingQueue.c
+*
+* Overview:
+*   This file contains the function definitions for a bounded
+*   blocking queue on top of the CircularList deque, for
+*   handing values between threads of a pipeline. One mutex
+*   guards the deque. Threads that have to wait park on one of
+*   two condition variables, and are counted while they do, so
+*   a push or pop only signals when a thread is actually
+*   parked on the other side. The batch calls move many values
+*   per lock acquisition and wake at most as many waiters as
+*   they have values or room for.
+*
+*
+* Input:
+*   No input is required.
+*
+* Output:
+*   No output
+************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include "blockingQueue.h"
+
+struct BlockingQueue
+{
+	struct CircularList* values;
+	int capacity;
+	int size;
+	int closed;
+
+	pthread_mutex_t lock;
+	pthread_cond_t notEmpty;
+	pthread_cond_t notFull;
+
+	// threads parked on each condition
+	int popWaiters;
+	int pushWaiters;
+};
+
+
+/*********************************************************************
+** Function: blockingQueueCreate
+**
+** Description: allocates an empty queue holding up to capacity values
+**
+** Parameters:  the capacity
+**
+** Pre-Conditions:  capacity is at least 1
+** Post-Conditions: returns an empty, open queue
+********************************************************************/
+struct BlockingQueue* blockingQueueCreate(int capacity)
+{
+    assert(capacity>=1);
+    struct BlockingQueue* queue = malloc(sizeof(struct BlockingQueue));
+    assert(queue!=0);
+    queue->values = circularListCreatePooled();
+    queue->capacity = capacity;
+    queue->size = 0;
+    queue->closed = 0;
+    pthread_mutex_init(&queue->lock, 0);
+    pthread_cond_init(&queue->notEmpty, 0);
+    pthread_cond_init(&queue->notFull, 0);
+    queue->popWaiters = 0;
+    queue->pushWaiters = 0;
+    return queue;
+}
+
+/*********************************************************************
+** Function: blockingQueueDestroy
+**
+** Description: frees the queue and any values still in it
+**
+** Parameters:  a BlockingQueue
+**
+** Pre-Conditions:  no thread is using the queue
+** Post-Conditions: the queue has been freed
+********************************************************************/
+void blockingQueueDestroy(struct BlockingQueue* queue)
+{
+    assert(queue!=0);
+    circularListDestroy(queue->values);
+    pthread_cond_destroy(&queue->notFull);
+    pthread_cond_destroy(&queue->notEmpty);
+    pthread_mutex_destroy(&queue->lock);
+    free(queue);
+}
+
+/*********************************************************************
+** Function: blockingQueueClose
+**
+** Description: stops the queue taking values and wakes every parked
+**              thread; consumers can still pop what is left
+**
+** Parameters:  a BlockingQueue
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: pushes fail, pops fail once the queue is empty
+********************************************************************/
+void blockingQueueClose(struct BlockingQueue* queue)
+{
+    assert(queue!=0);
+    pthread_mutex_lock(&queue->lock);
+    queue->closed = 1;
+    pthread_cond_broadcast(&queue->notEmpty);
+    pthread_cond_broadcast(&queue->notFull);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+/*********************************************************************
+** Function: blockingQueueSize
+**
+** Description: returns how many values are in the queue, which may
+**              already be stale when it returns
+**
+** Parameters:  a BlockingQueue
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: NONE
+********************************************************************/
+int blockingQueueSize(struct BlockingQueue* queue)
+{
+    assert(queue!=0);
+    pthread_mutex_lock(&queue->lock);
+    int size = queue->size;
+    pthread_mutex_unlock(&queue->lock);
+    return size;
+}
+
+/*********************************************************************
+** Function: deadline
+**
+** Description: returns the time timeoutNs nanoseconds from now, as
+**              pthread_cond_timedwait wants it
+**
+** Parameters:  a timeout
+**
+** Pre-Conditions:  timeoutNs is not negative
+** Post-Conditions: NONE
+********************************************************************/
+static struct timespec deadline(long timeoutNs)
+{
+    struct timespec until;
+    clock_gettime(CLOCK_REALTIME, &until);
+    until.tv_sec += timeoutNs / 1000000000;
+    until.tv_nsec += timeoutNs % 1000000000;
+    if(until.tv_nsec >= 1000000000){
+        until.tv_sec++;
+        until.tv_nsec -= 1000000000;
+    }
+    return until;
+}
+
+/*********************************************************************
+** Function: waitFor
+**
+** Description: parks the calling thread on a condition, counted in
+**              waiters so the other side knows to signal
+**
+** Parameters:  a queue, condition, its waiter count, and a deadline
+**              or null to wait without one
+**
+** Pre-Conditions:  the queue's lock is held
+** Post-Conditions: returns 0 if the deadline passed, the lock is held
+********************************************************************/
+static int waitFor(struct BlockingQueue* queue, pthread_cond_t* condition, int* waiters,
+                   const struct timespec* until)
+{
+    int result = 0;
+    (*waiters)++;
+    if(until == 0) pthread_cond_wait(condition, &queue->lock);
+    else result = pthread_cond_timedwait(condition, &queue->lock, until);
+    (*waiters)--;
+    return result != ETIMEDOUT;
+}
+
+/*********************************************************************
+** Function: wake
+**
+** Description: signals one parked thread for each value or free slot
+**              there is for them, and none at all if no thread is
+**              parked
+**
+** Parameters:  a condition, its waiter count, and how many values or
+**              free slots there are
+**
+** Pre-Conditions:  the queue's lock is held
+** Post-Conditions: NONE
+********************************************************************/
+static void wake(pthread_cond_t* condition, int waiters, int count)
+{
+    for(int i = 0; i < waiters && i < count; i++){
+        pthread_cond_signal(condition);
+    }
+}
+
+/*********************************************************************
+** Function: push
+**
+** Description: waits for room and adds a value to the back
+**
+** Parameters:  a queue, value and a deadline or null
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: returns 1 if the value went in, 0 if the queue
+**                  closed or the deadline passed first
+********************************************************************/
+static int push(struct BlockingQueue* queue, TYPE value, const struct timespec* until)
+{
+    assert(queue!=0);
+    pthread_mutex_lock(&queue->lock);
+    while(queue->size == queue->capacity && !queue->closed){
+        if(!waitFor(queue, &queue->notFull, &queue->pushWaiters, until)) break;
+    }
+    int pushed = !queue->closed && queue->size < queue->capacity;
+    if(pushed){
+        circularListAddBack(queue->values, value);
+        queue->size++;
+        wake(&queue->notEmpty, queue->popWaiters, 1);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return pushed;
+}
+
+/*********************************************************************
+** Function: pop
+**
+** Description: waits for a value and takes it from the front
+**
+** Parameters:  a queue, where to put the value and a deadline or null
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: returns 1 if a value was taken, 0 if the queue
+**                  closed empty or the deadline passed first
+********************************************************************/
+static int pop(struct BlockingQueue* queue, TYPE* value, const struct timespec* until)
+{
+    assert(queue!=0 && value!=0);
+    pthread_mutex_lock(&queue->lock);
+    while(queue->size == 0 && !queue->closed){
+        if(!waitFor(queue, &queue->notEmpty, &queue->popWaiters, until)) break;
+    }
+    int popped = queue->size > 0;
+    if(popped){
+        *value = circularListFront(queue->values);
+        circularListRemoveFront(queue->values);
+        queue->size--;
+        wake(&queue->notFull, queue->pushWaiters, 1);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return popped;
+}
+
+/*********************************************************************
+** Function: blockingQueuePush
+**
+** Description: waits as long as it takes for room and adds a value to
+**              the back
+**
+** Parameters:  a BlockingQueue and a value
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: returns 1 if the value went in, 0 if the queue
+**                  closed first
+********************************************************************/
+int blockingQueuePush(struct BlockingQueue* queue, TYPE value)
+{
+    return push(queue, value, 0);
+}
+
+/*********************************************************************
+** Function: blockingQueuePushTimed
+**
+** Description: waits at most timeoutNs nanoseconds for room and adds
+**              a value to the back
+**
+** Parameters:  a BlockingQueue, a value and a timeout
+**
+** Pre-Conditions:  timeoutNs is not negative
+** Post-Conditions: returns 1 if the value went in, 0 if the queue
+**                  closed or the timeout ran out first
+********************************************************************/
+int blockingQueuePushTimed(struct BlockingQueue* queue, TYPE value, long timeoutNs)
+{
+    assert(timeoutNs>=0);
+    struct timespec until = deadline(timeoutNs);
+    return push(queue, value, &until);
+}
+
+/*********************************************************************
+** Function: blockingQueuePop
+**
+** Description: waits as long as it takes for a value and takes it
+**              from the front
+**
+** Parameters:  a BlockingQueue and where to put the value
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: returns 1 if a value was taken, 0 if the queue
+**                  closed empty
+********************************************************************/
+int blockingQueuePop(struct BlockingQueue* queue, TYPE* value)
+{
+    return pop(queue, value, 0);
+}
+
+/*********************************************************************
+** Function: blockingQueuePopTimed
+**
+** Description: waits at most timeoutNs nanoseconds for a value and
+**              takes it from the front
+**
+** Parameters:  a BlockingQueue, where to put the value and a
+**              timeout
+**
+** Pre-Conditions:  timeoutNs is not negative
+** Post-Conditions: returns 1 if a value was taken, 0 if the queue
+**                  closed empty or the timeout ran out first
+********************************************************************/
+int blockingQueuePopTimed(struct BlockingQueue* queue, TYPE* value, long timeoutNs)
+{
+    assert(timeoutNs>=0);
+    struct timespec until = deadline(timeoutNs);
+    return pop(queue, value, &until);
+}
+
+/*********************************************************************
+** Function: blockingQueuePushBatch
+**
+** Description: adds values to the back, as many as fit each time the
+**              lock is taken, waiting for room in between
+**
+** Parameters:  a queue, values and how many
+**
+** Pre-Conditions:  count is not negative
+** Post-Conditions: returns how many values went in, all of them
+**                  unless the queue closed
+********************************************************************/
+int blockingQueuePushBatch(struct BlockingQueue* queue, const TYPE* values, int count)
+{
+    assert(queue!=0 && count>=0);
+    int pushed = 0;
+    pthread_mutex_lock(&queue->lock);
+    while(pushed < count && !queue->closed){
+        if(queue->size == queue->capacity){
+            waitFor(queue, &queue->notFull, &queue->pushWaiters, 0);
+            continue;
+        }
+        int room = queue->capacity - queue->size;
+        int take = count - pushed < room ? count - pushed : room;
+        circularListAddBackArray(queue->values, values + pushed, take);
+        queue->size += take;
+        pushed += take;
+        wake(&queue->notEmpty, queue->popWaiters, take);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return pushed;
+}
+
+/*********************************************************************
+** Function: blockingQueuePopBatch
+**
+** Description: waits for a value, then takes up to max values from
+**              the front under the same lock
+**
+** Parameters:  a queue, where to put the values and how many at most
+**
+** Pre-Conditions:  max is at least 1
+** Post-Conditions: returns how many values were taken, 0 only once
+**                  the queue is closed and empty
+********************************************************************/
+int blockingQueuePopBatch(struct BlockingQueue* queue, TYPE* out, int max)
+{
+    assert(queue!=0 && out!=0 && max>=1);
+    pthread_mutex_lock(&queue->lock);
+    while(queue->size == 0 && !queue->closed){
+        waitFor(queue, &queue->notEmpty, &queue->popWaiters, 0);
+    }
+    int popped = circularListRemoveFrontArray(queue->values, out, max);
+    queue->size -= popped;
+    wake(&queue->notFull, queue->pushWaiters, popped);
+    pthread_mutex_unlock(&queue->lock);
+    return popped;
+}
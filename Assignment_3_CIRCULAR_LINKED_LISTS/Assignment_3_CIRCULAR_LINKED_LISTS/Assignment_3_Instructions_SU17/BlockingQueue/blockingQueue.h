@@ -0,0 +1,30 @@
+#ifndef BLOCKING_QUEUE_H
+#define BLOCKING_QUEUE_H
+
+#include "../CLDeque/circularList.h"
+
+struct BlockingQueue;
+
+struct BlockingQueue* blockingQueueCreate(int capacity);
+void blockingQueueDestroy(struct BlockingQueue* queue);
+void blockingQueueClose(struct BlockingQueue* queue);
+int blockingQueueSize(struct BlockingQueue* queue);
+
+// Queue interface, safe to call from any number of threads. Push waits
+// while the queue is full and pop while it is empty; the timed calls
+// give up after timeoutNs nanoseconds. They return 0 once the queue is
+// closed, pops only after it has also been drained.
+
+int blockingQueuePush(struct BlockingQueue* queue, TYPE value);
+int blockingQueuePushTimed(struct BlockingQueue* queue, TYPE value, long timeoutNs);
+int blockingQueuePop(struct BlockingQueue* queue, TYPE* value);
+int blockingQueuePopTimed(struct BlockingQueue* queue, TYPE* value, long timeoutNs);
+
+// Batch interface, one lock acquisition moves as many values as fit.
+// PushBatch returns how many values went in before the queue closed,
+// PopBatch waits for at least one value and returns how many it took.
+
+int blockingQueuePushBatch(struct BlockingQueue* queue, const TYPE* values, int count);
+int blockingQueuePopBatch(struct BlockingQueue* queue, TYPE* out, int max);
+
+#endif
@@ -0,0 +1,201 @@
+/***********************************************************
+* Filename:                     blockingQueueBench.c
+*
+* Overview:
+*   Measures BlockingQueue throughput with 1 to N producer and
+*   consumer threads each, moving one value per call and in
+*   batches, against a CircularList behind a mutex that
+*   signals a condition variable on every push. Prints one
+*   CSV row per run.
+*
+* Input:
+*   [max threads per side] [values per producer] [batch size]
+*
+* Output:
+*   CSV on stdout
+************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include "blockingQueue.h"
+
+#define CAPACITY 4096
+
+// What pipelines built before BlockingQueue: every push signals
+struct LockedList
+{
+	struct CircularList* values;
+	int size;
+	int done;
+	pthread_mutex_t lock;
+	pthread_cond_t notEmpty;
+	pthread_cond_t notFull;
+};
+
+struct Run
+{
+	const char* mode;
+	struct BlockingQueue* queue;
+	struct LockedList locked;
+	long perProducer;
+	int batch;
+	atomic_int producing;
+	atomic_long sum;
+};
+
+static void lockedPush(struct LockedList* list, TYPE value)
+{
+	pthread_mutex_lock(&list->lock);
+	while(list->size == CAPACITY) pthread_cond_wait(&list->notFull, &list->lock);
+	circularListAddBack(list->values, value);
+	list->size++;
+	pthread_cond_signal(&list->notEmpty);
+	pthread_mutex_unlock(&list->lock);
+}
+
+static int lockedPop(struct LockedList* list, TYPE* value)
+{
+	pthread_mutex_lock(&list->lock);
+	while(list->size == 0 && !list->done) pthread_cond_wait(&list->notEmpty, &list->lock);
+	int popped = list->size > 0;
+	if(popped){
+		*value = circularListFront(list->values);
+		circularListRemoveFront(list->values);
+		list->size--;
+		pthread_cond_signal(&list->notFull);
+	}
+	pthread_mutex_unlock(&list->lock);
+	return popped;
+}
+
+static void* produce(void* arg)
+{
+	struct Run* run = arg;
+	if(strcmp(run->mode, "locked") == 0){
+		for(long i = 0; i < run->perProducer; i++) lockedPush(&run->locked, (TYPE)i);
+	}
+	else if(strcmp(run->mode, "single") == 0){
+		for(long i = 0; i < run->perProducer; i++) blockingQueuePush(run->queue, (TYPE)i);
+	}
+	else {
+		TYPE values[run->batch];
+		for(long i = 0; i < run->perProducer; i += run->batch){
+			int count = run->perProducer - i < run->batch ? (int)(run->perProducer - i) : run->batch;
+			for(int j = 0; j < count; j++) values[j] = (TYPE)(i + j);
+			blockingQueuePushBatch(run->queue, values, count);
+		}
+	}
+
+	// the last producer out lets the consumers finish
+	if(atomic_fetch_sub(&run->producing, 1) == 1){
+		if(run->queue != 0) blockingQueueClose(run->queue);
+		else {
+			pthread_mutex_lock(&run->locked.lock);
+			run->locked.done = 1;
+			pthread_cond_broadcast(&run->locked.notEmpty);
+			pthread_mutex_unlock(&run->locked.lock);
+		}
+	}
+	return 0;
+}
+
+static void* consume(void* arg)
+{
+	struct Run* run = arg;
+	long sum = 0;
+	TYPE value;
+	if(strcmp(run->mode, "locked") == 0){
+		while(lockedPop(&run->locked, &value)) sum += (long)value;
+	}
+	else if(strcmp(run->mode, "single") == 0){
+		while(blockingQueuePop(run->queue, &value)) sum += (long)value;
+	}
+	else {
+		TYPE values[run->batch];
+		int count;
+		while((count = blockingQueuePopBatch(run->queue, values, run->batch)) > 0){
+			for(int j = 0; j < count; j++) sum += (long)values[j];
+		}
+	}
+	atomic_fetch_add(&run->sum, sum);
+	return 0;
+}
+
+static double now()
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void bench(const char* mode, int threads, long perProducer, int batch)
+{
+	struct Run run;
+	run.mode = mode;
+	run.queue = 0;
+	if(strcmp(mode, "locked") == 0){
+		run.locked.values = circularListCreatePooled();
+		run.locked.size = 0;
+		run.locked.done = 0;
+		pthread_mutex_init(&run.locked.lock, 0);
+		pthread_cond_init(&run.locked.notEmpty, 0);
+		pthread_cond_init(&run.locked.notFull, 0);
+	}
+	else run.queue = blockingQueueCreate(CAPACITY);
+	run.perProducer = perProducer;
+	run.batch = batch;
+	atomic_init(&run.producing, threads);
+	atomic_init(&run.sum, 0);
+
+	pthread_t producers[threads], consumers[threads];
+	double start = now();
+	for(int i = 0; i < threads; i++){
+		pthread_create(&consumers[i], 0, consume, &run);
+		pthread_create(&producers[i], 0, produce, &run);
+	}
+	for(int i = 0; i < threads; i++){
+		pthread_join(producers[i], 0);
+		pthread_join(consumers[i], 0);
+	}
+	double seconds = now() - start;
+
+	// every value pushed must come out exactly once
+	long total = perProducer * threads;
+	long expected = threads * (perProducer * (perProducer - 1) / 2);
+	if(atomic_load(&run.sum) != expected){
+		fprintf(stderr, "lost or duplicated values\n");
+		exit(1);
+	}
+
+	printf("%s,%d,%d,%d,%ld,%.6f,%.2f,%.0f\n", mode, threads, threads,
+	       strcmp(mode, "batch") == 0 ? batch : 1, total, seconds, seconds * 1e9 / total, total / seconds);
+	if(run.queue != 0) blockingQueueDestroy(run.queue);
+	else {
+		circularListDestroy(run.locked.values);
+		pthread_cond_destroy(&run.locked.notFull);
+		pthread_cond_destroy(&run.locked.notEmpty);
+		pthread_mutex_destroy(&run.locked.lock);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int maxThreads = argc > 1 ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+	long perProducer = argc > 2 ? atol(argv[2]) : 1000000;
+	int batch = argc > 3 ? atoi(argv[3]) : 64;
+	if(maxThreads < 1) maxThreads = 1;
+	if(batch < 1) batch = 1;
+
+	printf("mode,producers,consumers,batch,operations,seconds,ns_per_op,ops_per_sec\n");
+	for(int threads = 1; threads <= maxThreads; threads++){
+		bench("locked", threads, perProducer, batch);
+		bench("single", threads, perProducer, batch);
+		bench("batch", threads, perProducer, batch);
+	}
+	return 0;
+}
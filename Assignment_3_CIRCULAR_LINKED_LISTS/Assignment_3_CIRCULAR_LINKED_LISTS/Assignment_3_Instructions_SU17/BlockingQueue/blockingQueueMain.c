@@ -0,0 +1,30 @@
+#include "blockingQueue.h"
+#include <stdio.h>
+
+int main()
+{
+	struct BlockingQueue* queue = blockingQueueCreate(4);
+	TYPE values[] = {1, 2, 3, 4, 5, 6};
+	TYPE out[6];
+
+	printf("%d\n", blockingQueuePushBatch(queue, values, 3));
+	printf("%d\n", blockingQueuePushTimed(queue, 4, 1000000));
+	if(!blockingQueuePushTimed(queue, 5, 1000000)) printf("full\n");
+
+	int count = blockingQueuePopBatch(queue, out, 6);
+	for(int i = 0; i < count; i++){
+		printf("%g ", out[i]);
+	}
+	printf("\n");
+	if(!blockingQueuePopTimed(queue, out, 1000000)) printf("empty\n");
+
+	blockingQueuePush(queue, 7);
+	blockingQueueClose(queue);
+	if(!blockingQueuePush(queue, 8)) printf("closed\n");
+	while(blockingQueuePop(queue, out)){
+		printf("%g\n", out[0]);
+	}
+
+	blockingQueueDestroy(queue);
+	return 0;
+}
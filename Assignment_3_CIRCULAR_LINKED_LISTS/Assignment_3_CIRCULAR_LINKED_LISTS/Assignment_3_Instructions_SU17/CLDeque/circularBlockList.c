@@ -0,0 +1,1576 @@
+/***********************************************************
+* Filename:                     circularBlockList.c
+*
+* Overview:
+*   This file contains an alternative implementation of the
+*   CircularList deque declared in circularList.h. Values are
+*   stored in fixed size contiguous blocks and the blocks are
+*   kept in a ring of block pointers, so both ends grow and
+*   shrink in amortized O(1) and any index is reachable in O(1).
+*   Link against this file instead of circularList.c to use it.
+*
+*
+* Input:
+*   No input is required.
+*
+* Output:
+*   No output
+************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "circularList.h"
+#include "circularListScan.h"
+#include "circularListMove.h"
+#include "circularListSort.h"
+
+// Number of values held by each block, must be a power of two
+#ifndef BLOCK_SIZE
+#define BLOCK_SIZE 128
+#endif
+
+// Instrumentation counters, compiled out unless CS261_STATS is defined
+#ifdef CS261_STATS
+#define STAT_ADD(list, counter, n) ((list)->stats.counter += (n))
+#define STAT_PEAK(list) \
+    do { if((list)->size > (list)->stats.peakSize) (list)->stats.peakSize = (list)->size; } while(0)
+#else
+#define STAT_ADD(list, counter, n) ((void)0)
+#define STAT_PEAK(list) ((void)0)
+#endif
+
+// Contiguous run of values
+struct Block
+{
+	TYPE values[BLOCK_SIZE];
+	struct Block * next;
+};
+
+// Deque of blocks, the ring is a power of two sized array of block
+// pointers starting at firstBlock
+struct CircularList
+{
+	int size;
+	struct Block** ring;
+	int ringCapacity;
+	int firstBlock;
+	int blockCount;
+	int frontOffset;
+
+	// when set the front of the deque is the last stored value
+	int reversed;
+
+	// emptied blocks kept around for reuse, pooled lists keep them all
+	int pooled;
+	struct Block* spares;
+	int spareCount;
+
+#ifdef CS261_STATS
+	struct CircularListStats stats;
+#endif
+};
+
+
+/*********************************************************************
+** Function: init
+**
+** Description: allocates the list's block ring and sets the size and
+**              offsets of an empty list
+**
+** Parameters:  a pointer to a list structure
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: the ring has room for a few blocks, none are in use
+********************************************************************/
+static void init(struct CircularList* list)
+{
+    list->ringCapacity = 4;
+    list->ring = (struct Block**)malloc(list->ringCapacity * sizeof(struct Block*));
+
+    // assert malloc occured properly
+    assert(list->ring!=0);
+
+    list->size = 0;
+    list->firstBlock = 0;
+    list->blockCount = 0;
+    list->frontOffset = 0;
+    list->reversed = 0;
+    list->pooled = 0;
+    list->spares = 0;
+    list->spareCount = 0;
+
+    circularListStatsReset(list);
+}
+
+/*********************************************************************
+** Function: blockAt
+**
+** Description: returns the i-th block in use, counting from the front
+**
+** Parameters:  a CircularList and block number
+**
+** Pre-Conditions:  0 <= i < blockCount
+** Post-Conditions: NONE
+********************************************************************/
+static struct Block* blockAt(struct CircularList* list, int i)
+{
+    return list->ring[(list->firstBlock + i) & (list->ringCapacity - 1)];
+}
+
+/*********************************************************************
+** Function: slotAt
+**
+** Description: returns the address of the value at the given index
+**
+** Parameters:  a CircularList and index
+**
+** Pre-Conditions:  0 <= index < size
+** Post-Conditions: NONE
+********************************************************************/
+static TYPE* slotAt(struct CircularList* list, int index)
+{
+    int position = list->frontOffset + index;
+    return &blockAt(list, position / BLOCK_SIZE)->values[position % BLOCK_SIZE];
+}
+
+/*********************************************************************
+** Function: runLength
+**
+** Description: returns how many values from the given index on sit
+**              in the same block, so slotAt(list, index) starts a run
+**              of that many contiguous values
+**
+** Parameters:  a CircularList and index
+**
+** Pre-Conditions:  0 <= index < size
+** Post-Conditions: NONE
+********************************************************************/
+static int runLength(struct CircularList* list, int index)
+{
+    int room = BLOCK_SIZE - (list->frontOffset + index) % BLOCK_SIZE;
+    return list->size - index < room ? list->size - index : room;
+}
+
+/*********************************************************************
+** Function: createBlock
+**
+** Description: returns an empty block, reusing a spare if there is one
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: the returned block is owned by the caller
+********************************************************************/
+static struct Block* createBlock(struct CircularList* list)
+{
+    struct Block * block = list->spares;
+    if(block!=0){
+        list->spares = block->next;
+        list->spareCount--;
+        return block;
+    }
+
+    block = (struct Block*)malloc(sizeof(struct Block));
+
+    // assert memory allocated properly
+    assert(block!=0);
+    STAT_ADD(list, allocations, 1);
+    return block;
+}
+
+/*********************************************************************
+** Function: releaseBlock
+**
+** Description: keeps an emptied block as a spare, unpooled lists only
+**              keep one so a list bouncing on a block boundary does not
+**              malloc and free on every operation
+**
+** Parameters:  a CircularList and Block
+**
+** Pre-Conditions:  the block is no longer in the ring
+** Post-Conditions: the block is a spare or has been freed
+********************************************************************/
+static void releaseBlock(struct CircularList* list, struct Block* block)
+{
+    if(!list->pooled && list->spareCount > 0){
+        free(block);
+        STAT_ADD(list, frees, 1);
+        return;
+    }
+    block->next = list->spares;
+    list->spares = block;
+    list->spareCount++;
+}
+
+/*********************************************************************
+** Function: growRing
+**
+** Description: doubles the ring of block pointers, unwrapping the
+**              blocks in use to the start of the new ring
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: ringCapacity has doubled and firstBlock is 0
+********************************************************************/
+static void growRing(struct CircularList* list)
+{
+    int capacity = list->ringCapacity * 2;
+    struct Block** ring = (struct Block**)malloc(capacity * sizeof(struct Block*));
+    assert(ring!=0);
+    STAT_ADD(list, allocations, 1);
+
+    for(int i = 0; i < list->blockCount; i++){
+        ring[i] = blockAt(list, i);
+    }
+    free(list->ring);
+    STAT_ADD(list, frees, 1);
+    list->ring = ring;
+    list->ringCapacity = capacity;
+    list->firstBlock = 0;
+}
+
+/*********************************************************************
+** Function: pushFrontBlock
+**
+** Description: puts a new empty block in front of the blocks in use
+**              and moves the front offset past its end
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions:  frontOffset is 0, so the front block is full
+** Post-Conditions: frontOffset is BLOCK_SIZE in the new front block
+********************************************************************/
+static void pushFrontBlock(struct CircularList* list)
+{
+    if(list->blockCount == list->ringCapacity){
+        growRing(list);
+    }
+    list->firstBlock = (list->firstBlock - 1) & (list->ringCapacity - 1);
+    list->ring[list->firstBlock] = createBlock(list);
+    list->blockCount++;
+    list->frontOffset = BLOCK_SIZE;
+}
+
+/*********************************************************************
+** Function: pushBackBlock
+**
+** Description: puts a new empty block behind the blocks in use
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions:  the back block is full
+** Post-Conditions: blockCount has grown by one
+********************************************************************/
+static void pushBackBlock(struct CircularList* list)
+{
+    if(list->blockCount == list->ringCapacity){
+        growRing(list);
+    }
+    list->ring[(list->firstBlock + list->blockCount) & (list->ringCapacity - 1)] = createBlock(list);
+    list->blockCount++;
+}
+
+/*********************************************************************
+** Function: popFrontBlock
+**
+** Description: releases the front block and resets the front offset
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions:  no value left in the list lives in the front block
+** Post-Conditions: frontOffset is 0 in the next block
+********************************************************************/
+static void popFrontBlock(struct CircularList* list)
+{
+    releaseBlock(list, list->ring[list->firstBlock]);
+    list->firstBlock = (list->firstBlock + 1) & (list->ringCapacity - 1);
+    list->blockCount--;
+    list->frontOffset = 0;
+}
+
+/*********************************************************************
+** Function: popBackBlock
+**
+** Description: releases the back block
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions:  no value left in the list lives in the back block
+** Post-Conditions: blockCount has shrunk by one
+********************************************************************/
+static void popBackBlock(struct CircularList* list)
+{
+    list->blockCount--;
+    releaseBlock(list, blockAt(list, list->blockCount));
+    if(list->blockCount == 0){
+        list->frontOffset = 0;
+    }
+}
+
+/*********************************************************************
+** Function: circularListCreate
+**
+** Description: allocates and initializes a list
+**
+**
+** Parameters:  none
+**
+** Pre-Conditions: none
+** Post-Conditions: returns an allocated and initiallized list
+********************************************************************/
+struct CircularList* circularListCreate()
+{
+	struct CircularList* list = malloc(sizeof(struct CircularList));
+	assert(list!=0);
+	init(list);
+	return list;
+}
+
+/*********************************************************************
+** Function: circularListCreatePooled
+**
+** Description: allocates and initializes a list that keeps every block
+**              it empties for reuse instead of freeing it
+**
+** Parameters:  none
+**
+** Pre-Conditions: none
+** Post-Conditions: returns an empty pooled list, its blocks are only
+**                  released by circularListDestroy
+********************************************************************/
+struct CircularList* circularListCreatePooled()
+{
+	struct CircularList* list = circularListCreate();
+	list->pooled = 1;
+	return list;
+}
+
+/*********************************************************************
+** Function: circularListDestroy
+**
+** Description: destroys a CircularList
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the passed list has space allocated for it
+** Post-Conditions: every block, the ring and the list have been freed
+********************************************************************/
+void circularListDestroy(struct CircularList* list)
+{
+    assert(list!=0);
+
+    for(int i = 0; i < list->blockCount; i++){
+        free(blockAt(list, i));
+    }
+    while(list->spares!=0){
+        struct Block * block = list->spares;
+        list->spares = block->next;
+        free(block);
+    }
+    free(list->ring);
+    free(list);
+}
+
+/*********************************************************************
+** Function: addFront
+** Description: stores a value before the first stored value
+**
+**
+** Parameters:  a CircularList and Value
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the value passed is stored first
+**
+********************************************************************/
+static void addFront(struct CircularList* list, TYPE value)
+{
+    // the front block is full, put a new one in front of it
+    if(list->frontOffset == 0){
+        pushFrontBlock(list);
+    }
+
+    list->frontOffset--;
+    list->size++;
+    STAT_PEAK(list);
+    *slotAt(list, 0) = value;
+}
+
+/*********************************************************************
+** Function: addBack
+** Description: stores a value after the last stored value
+**
+**
+** Parameters:  a CircularList and Value
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the value passed is stored last
+**
+********************************************************************/
+static void addBack(struct CircularList* list, TYPE value)
+{
+    // the back block is full, put a new one behind it
+    int position = list->frontOffset + list->size;
+    if(position == list->blockCount * BLOCK_SIZE){
+        pushBackBlock(list);
+    }
+
+    list->size++;
+    STAT_PEAK(list);
+    *slotAt(list, list->size - 1) = value;
+}
+
+/*********************************************************************
+** Function: removeFront
+** Description: removes the first stored value
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list is not empty
+** Post-Conditions: the first stored value has been removed
+**
+**
+********************************************************************/
+static void removeFront(struct CircularList* list)
+{
+    list->frontOffset++;
+    list->size--;
+
+    // the front block ran out of values
+    if(list->frontOffset == BLOCK_SIZE || list->size == 0){
+        popFrontBlock(list);
+    }
+}
+
+/*********************************************************************
+** Function: removeBack
+** Description: removes the last stored value
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list is not empty
+** Post-Conditions: the last stored value has been removed
+**
+**
+*******************************************************************/
+static void removeBack(struct CircularList* list)
+{
+    list->size--;
+
+    // the back block ran out of values
+    int position = list->frontOffset + list->size;
+    if(position == (list->blockCount - 1) * BLOCK_SIZE || list->size == 0){
+        popBackBlock(list);
+    }
+}
+
+/*********************************************************************
+** Function: copyValues
+** Description: copies run values of the array, starting at first, into
+**              dest; with backward set the array is read last to first
+**
+** Parameters:  destination, array of values, first value to copy,
+**              number to copy, array length and direction
+**
+** Pre-Conditions: first + run <= count
+** Post-Conditions: dest holds the run of values
+**
+*******************************************************************/
+static void copyValues(TYPE* dest, const TYPE* values, int first, int run,
+                       int count, int backward)
+{
+    if(!backward){
+        memcpy(dest, values + first, run * sizeof(TYPE));
+        return;
+    }
+    for(int i = 0; i < run; i++){
+        dest[i] = values[count - 1 - (first + i)];
+    }
+}
+
+/*********************************************************************
+** Function: addFrontValues
+** Description: stores count values before the first stored value,
+**              copying a block's worth at a time, values[0] first or
+**              last when backward is set
+**
+** Parameters:  a CircularList, array of values, number of values and
+**              direction
+**
+** Pre-Conditions: the list has been initialized, values holds count
+**                 values
+** Post-Conditions: the values are stored first
+**
+*******************************************************************/
+static void addFrontValues(struct CircularList* list, const TYPE* values,
+                           int count, int backward)
+{
+    // fill blocks from the back of the array toward its front
+    int left = count;
+    while(left > 0){
+        if(list->frontOffset == 0){
+            pushFrontBlock(list);
+        }
+        int run = left < list->frontOffset ? left : list->frontOffset;
+        list->frontOffset -= run;
+        left -= run;
+        copyValues(&list->ring[list->firstBlock]->values[list->frontOffset],
+                   values, left, run, count, backward);
+        list->size += run;
+        STAT_PEAK(list);
+    }
+}
+
+/*********************************************************************
+** Function: addBackValues
+** Description: stores count values after the last stored value,
+**              copying a block's worth at a time, values[0] first or
+**              last when backward is set
+**
+** Parameters:  a CircularList, array of values, number of values and
+**              direction
+**
+** Pre-Conditions: the list has been initialized, values holds count
+**                 values
+** Post-Conditions: the values are stored last
+**
+*******************************************************************/
+static void addBackValues(struct CircularList* list, const TYPE* values,
+                          int count, int backward)
+{
+    int done = 0;
+    while(done < count){
+        int position = list->frontOffset + list->size;
+        if(position == list->blockCount * BLOCK_SIZE){
+            pushBackBlock(list);
+        }
+        int offset = position % BLOCK_SIZE;
+        int run = count - done < BLOCK_SIZE - offset ? count - done : BLOCK_SIZE - offset;
+        copyValues(&blockAt(list, position / BLOCK_SIZE)->values[offset],
+                   values, done, run, count, backward);
+        done += run;
+        list->size += run;
+        STAT_PEAK(list);
+    }
+}
+
+/*********************************************************************
+** Function: removeFrontValues
+** Description: removes up to count values from the start of storage,
+**              copying them into out a block's worth at a time
+**
+** Parameters:  a CircularList, output array and maximum number to
+**              remove
+**
+** Pre-Conditions: out has room for count values
+** Post-Conditions: returns how many values were removed
+**
+*******************************************************************/
+static int removeFrontValues(struct CircularList* list, TYPE* out, int count)
+{
+    if(count > list->size) count = list->size;
+
+    int removed = 0;
+    while(removed < count){
+        int run = BLOCK_SIZE - list->frontOffset;
+        if(run > count - removed) run = count - removed;
+        memcpy(out + removed, &list->ring[list->firstBlock]->values[list->frontOffset],
+               run * sizeof(TYPE));
+        removed += run;
+        list->frontOffset += run;
+        list->size -= run;
+        if(list->frontOffset == BLOCK_SIZE || list->size == 0){
+            popFrontBlock(list);
+        }
+    }
+    return count;
+}
+
+/*********************************************************************
+** Function: removeBackValues
+** Description: removes up to count values from the end of storage,
+**              copying them into out in the order they are removed
+**
+** Parameters:  a CircularList, output array and maximum number to
+**              remove
+**
+** Pre-Conditions: out has room for count values
+** Post-Conditions: returns how many values were removed
+**
+*******************************************************************/
+static int removeBackValues(struct CircularList* list, TYPE* out, int count)
+{
+    if(count > list->size) count = list->size;
+
+    int removed = 0;
+    while(removed < count){
+        // values in the back block end just before position
+        int position = list->frontOffset + list->size;
+        int start = (list->blockCount - 1) * BLOCK_SIZE;
+        if(start < list->frontOffset) start = list->frontOffset;
+        int run = position - start;
+        if(run > count - removed) run = count - removed;
+
+        TYPE * values = blockAt(list, list->blockCount - 1)->values;
+        for(int i = 1; i <= run; i++){
+            out[removed++] = values[(position - i) % BLOCK_SIZE];
+        }
+        list->size -= run;
+        if(position - run == (list->blockCount - 1) * BLOCK_SIZE || list->size == 0){
+            popBackBlock(list);
+        }
+    }
+    return count;
+}
+
+/*********************************************************************
+** Function: circularListAddFront
+** Description: adds a value to the front of the deque
+**
+**
+** Parameters:  a CircularList and Value
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the value passed is at the front
+**
+********************************************************************/
+void circularListAddFront(struct CircularList* list, TYPE value)
+{
+    assert(list!=0);
+
+    if(list->reversed) addBack(list, value);
+    else addFront(list, value);
+}
+
+/*********************************************************************
+** Function: circularListAddBack
+** Description: adds a value to the back of the deque
+**
+**
+** Parameters:  a CircularList and Value
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the value passed is at the back
+**
+********************************************************************/
+void circularListAddBack(struct CircularList* list, TYPE value)
+{
+    assert(list!=0);
+
+    if(list->reversed) addFront(list, value);
+    else addBack(list, value);
+}
+
+/*********************************************************************
+** Function: circularListFront
+** Description: returns the value at the front of the circularList
+**
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized and is not empty
+** Post-Conditions: the first value has been returned
+**
+********************************************************************/
+TYPE circularListFront(struct CircularList* list)
+{
+    assert(list!=0 && list->size>0);
+
+    return *slotAt(list, list->reversed ? list->size - 1 : 0);
+}
+
+/*********************************************************************
+ ** Function: circularListBack
+ ** Description: returns the value at the back of the circularList
+ **
+ ** Parameters:  a CircularList
+ **
+ ** Pre-Conditions: the list has been initialized and is not empty
+ ** Post-Conditions: the last value has been returned
+ **
+ **
+ ********************************************************************/
+TYPE circularListBack(struct CircularList* list)
+{
+    assert(list!=0 && list->size>0);
+
+    return *slotAt(list, list->reversed ? 0 : list->size - 1);
+}
+
+/*********************************************************************
+ ** Function: circularListGet
+ ** Description: returns the value at the given index from the front
+ **
+ ** Parameters:  a CircularList and index
+ **
+ ** Pre-Conditions: 0 <= index < size
+ ** Post-Conditions: the value at index has been returned
+ **
+ **
+ ********************************************************************/
+TYPE circularListGet(struct CircularList* list, int index)
+{
+    assert(list!=0);
+    assert(index>=0 && index<list->size);
+
+    STAT_ADD(list, traversed, 1);
+    return *slotAt(list, list->reversed ? list->size - 1 - index : index);
+}
+
+/*********************************************************************
+** Function: circularListRemoveFront
+** Description: removes the value at the front of the circularList
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized and is not empty
+** Post-Conditions: the first value has been removed
+**
+**
+********************************************************************/
+void circularListRemoveFront(struct CircularList* list)
+{
+    assert(list!=0);
+    assert(list->size>0);
+
+    if(list->reversed) removeBack(list);
+    else removeFront(list);
+}
+
+/*********************************************************************
+** Function: circularListRemoveBack
+** Description: removes the value at the back of the circularList
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized and is not empty
+** Post-Conditions: the last value has been removed
+**
+**
+*******************************************************************/
+void circularListRemoveBack(struct CircularList* list)
+{
+    assert(list!=0);
+    assert(list->size>0);
+
+    if(list->reversed) removeFront(list);
+    else removeBack(list);
+}
+
+/*********************************************************************
+** Function: circularListAddFrontArray
+** Description: adds count values to the front of the deque, keeping
+**              their array order
+**
+** Parameters:  a CircularList, array of values and number of values
+**
+** Pre-Conditions: the list has been initialized, values holds count
+**                 values
+** Post-Conditions: the values are at the front, values[0] first
+**
+*******************************************************************/
+void circularListAddFrontArray(struct CircularList* list, const TYPE* values, int count)
+{
+    assert(list!=0);
+    assert(count>=0 && (values!=0 || count==0));
+
+    // a reversed list's front is the end of storage
+    if(list->reversed) addBackValues(list, values, count, 1);
+    else addFrontValues(list, values, count, 0);
+}
+
+/*********************************************************************
+** Function: circularListAddBackArray
+** Description: adds count values to the back of the deque in array
+**              order
+**
+** Parameters:  a CircularList, array of values and number of values
+**
+** Pre-Conditions: the list has been initialized, values holds count
+**                 values
+** Post-Conditions: the values are at the back, values[count-1] last
+**
+*******************************************************************/
+void circularListAddBackArray(struct CircularList* list, const TYPE* values, int count)
+{
+    assert(list!=0);
+    assert(count>=0 && (values!=0 || count==0));
+
+    // a reversed list's back is the start of storage
+    if(list->reversed) addFrontValues(list, values, count, 1);
+    else addBackValues(list, values, count, 0);
+}
+
+/*********************************************************************
+** Function: circularListRemoveFrontArray
+** Description: removes up to count values from the front, copying them
+**              front to back into out
+**
+** Parameters:  a CircularList, output array and maximum number to
+**              remove
+**
+** Pre-Conditions: the list has been initialized, out has room for
+**                 count values
+** Post-Conditions: returns how many values were removed
+**
+*******************************************************************/
+int circularListRemoveFrontArray(struct CircularList* list, TYPE* out, int count)
+{
+    assert(list!=0 && count>=0);
+
+    if(list->reversed) return removeBackValues(list, out, count);
+    return removeFrontValues(list, out, count);
+}
+
+/*********************************************************************
+** Function: circularListRemoveBackArray
+** Description: removes up to count values from the back, copying them
+**              into out in the order they are removed, back first
+**
+** Parameters:  a CircularList, output array and maximum number to
+**              remove
+**
+** Pre-Conditions: the list has been initialized, out has room for
+**                 count values
+** Post-Conditions: returns how many values were removed
+**
+*******************************************************************/
+int circularListRemoveBackArray(struct CircularList* list, TYPE* out, int count)
+{
+    assert(list!=0 && count>=0);
+
+    if(list->reversed) return removeFrontValues(list, out, count);
+    return removeBackValues(list, out, count);
+}
+
+/*********************************************************************
+** Function: circularListDrain
+** Description: removes every value, copying them front to back into out
+**
+** Parameters:  a CircularList and output array
+**
+** Pre-Conditions: the list has been initialized, out has room for
+**                 every value in the list
+** Post-Conditions: the list is empty, returns how many values were
+**                  removed
+**
+*******************************************************************/
+int circularListDrain(struct CircularList* list, TYPE* out)
+{
+    assert(list!=0);
+
+    return circularListRemoveFrontArray(list, out, list->size);
+}
+
+/*********************************************************************
+** Function: circularListContains
+** Description: returns 1 if the list holds value and 0 if not
+**
+** Parameters:  a CircularList and value to look for
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+int circularListContains(struct CircularList* list, TYPE value)
+{
+    assert(list!=0);
+
+    for(int i = 0; i < list->size; i += runLength(list, i)){
+        if(findRun(slotAt(list, i), runLength(list, i), value) >= 0){
+            STAT_ADD(list, traversed, i + runLength(list, i));
+            return 1;
+        }
+    }
+    STAT_ADD(list, traversed, list->size);
+    return 0;
+}
+
+/*********************************************************************
+** Function: circularListFindIndex
+** Description: returns the index from the front of the first value
+**              equal to value; a reversed list is scanned from the
+**              back of storage
+**
+** Parameters:  a CircularList and value to look for
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: returns the index, or -1 if the list does not hold
+**                  value
+**
+**
+*******************************************************************/
+int circularListFindIndex(struct CircularList* list, TYPE value)
+{
+    assert(list!=0);
+
+    if(!list->reversed){
+        for(int i = 0; i < list->size; i += runLength(list, i)){
+            int found = findRun(slotAt(list, i), runLength(list, i), value);
+            if(found >= 0){
+                STAT_ADD(list, traversed, i + found + 1);
+                return i + found;
+            }
+        }
+        STAT_ADD(list, traversed, list->size);
+        return -1;
+    }
+
+    // walk the runs back to front, the last match in a run is the one
+    // nearest the front of a reversed list
+    for(int end = list->size; end > 0; ){
+        int start = end - 1 - (list->frontOffset + end - 1) % BLOCK_SIZE;
+        if(start < 0) start = 0;
+        TYPE * values = slotAt(list, start);
+        if(findRun(values, end - start, value) >= 0){
+            int last = end - start - 1;
+            while(!EQ(values[last], value)) last--;
+            STAT_ADD(list, traversed, list->size - start);
+            return list->size - 1 - (start + last);
+        }
+        end = start;
+    }
+    STAT_ADD(list, traversed, list->size);
+    return -1;
+}
+
+/*********************************************************************
+** Function: circularListCount
+** Description: returns how many values equal value
+**
+** Parameters:  a CircularList and value to count
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+int circularListCount(struct CircularList* list, TYPE value)
+{
+    assert(list!=0);
+
+    int found = 0;
+    for(int i = 0; i < list->size; i += runLength(list, i)){
+        found += countRun(slotAt(list, i), runLength(list, i), value);
+    }
+    STAT_ADD(list, traversed, list->size);
+    return found;
+}
+
+/*********************************************************************
+** Function: circularListSum
+** Description: returns the sum of every value, added a block at a
+**              time in storage order, so a sum of doubles may round
+**              differently than a front to back loop
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: returns the sum, 0 for an empty list
+**
+**
+*******************************************************************/
+TYPE circularListSum(struct CircularList* list)
+{
+    assert(list!=0);
+
+    TYPE sum = 0;
+    for(int i = 0; i < list->size; i += runLength(list, i)){
+        sum += sumRun(slotAt(list, i), runLength(list, i));
+    }
+    STAT_ADD(list, traversed, list->size);
+    return sum;
+}
+
+/*********************************************************************
+** Function: circularListMin
+** Description: returns the smallest value in the list
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized and is not empty
+** Post-Conditions: returns the smallest value
+**
+**
+*******************************************************************/
+TYPE circularListMin(struct CircularList* list)
+{
+    assert(list!=0 && list->size>0);
+
+    TYPE min = *slotAt(list, 0);
+    for(int i = 0; i < list->size; i += runLength(list, i)){
+        TYPE run = minRun(slotAt(list, i), runLength(list, i));
+        if(LT(run, min)) min = run;
+    }
+    STAT_ADD(list, traversed, list->size);
+    return min;
+}
+
+/*********************************************************************
+** Function: circularListMax
+** Description: returns the largest value in the list
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized and is not empty
+** Post-Conditions: returns the largest value
+**
+**
+*******************************************************************/
+TYPE circularListMax(struct CircularList* list)
+{
+    assert(list!=0 && list->size>0);
+
+    TYPE max = *slotAt(list, 0);
+    for(int i = 0; i < list->size; i += runLength(list, i)){
+        TYPE run = maxRun(slotAt(list, i), runLength(list, i));
+        if(LT(max, run)) max = run;
+    }
+    STAT_ADD(list, traversed, list->size);
+    return max;
+}
+
+/*********************************************************************
+** Function: circularListisEmpty
+** Description: returns 1 if list is empty and 0 if not
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: returns 1 if list is empty and 0 if not
+**
+**
+*******************************************************************/
+int circularListIsEmpty(struct CircularList* list)
+{
+    assert(list!=0);
+    if(list->size == 0){
+        return 1;
+    }
+	return 0;
+}
+
+/*********************************************************************
+** Function: circularListPrint
+** Description: prints each value in the list, a block at a time
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the list of values has been printed
+**
+**
+*******************************************************************/
+void circularListPrint(struct CircularList* list)
+{
+    assert(list!=0);
+
+    if(list->reversed){
+        for(int i = list->size - 1; i >= 0; i--){
+            printf("%f ", *slotAt(list, i));
+        }
+        printf("\n");
+        return;
+    }
+
+    int offset = list->frontOffset;
+    int remaining = list->size;
+    for(int i = 0; remaining > 0; i++){
+        struct Block * block = blockAt(list, i);
+
+        // scan the contiguous run held by this block
+        int end = offset + remaining < BLOCK_SIZE ? offset + remaining : BLOCK_SIZE;
+        for(int j = offset; j < end; j++){
+            printf("%f ", block->values[j]);
+        }
+        remaining -= end - offset;
+        offset = 0;
+    }
+    printf("\n");
+}
+
+/*********************************************************************
+** Function: circularListReverse
+** Description: reverses the list by swapping values from both ends
+**              toward the middle, nothing is allocated
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the list of values has been reversed
+**
+**
+*******************************************************************/
+void circularListReverse(struct CircularList* list)
+{
+    assert(list!=0);
+
+    for(int i = 0, j = list->size - 1; i < j; i++, j--){
+        TYPE * front = slotAt(list, i);
+        TYPE * back = slotAt(list, j);
+        TYPE temp = *front;
+        *front = *back;
+        *back = temp;
+    }
+    STAT_ADD(list, traversed, list->size);
+}
+
+/*********************************************************************
+** Function: circularListReverseLazy
+** Description: reverses the list in O(1) by flipping which end of
+**              storage is the front, every deque operation honors it
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: front and back have traded places
+**
+**
+*******************************************************************/
+void circularListReverseLazy(struct CircularList* list)
+{
+    assert(list!=0);
+
+    list->reversed = !list->reversed;
+}
+
+/*********************************************************************
+** Function: circularListCursorBegin
+** Description: puts a cursor on the front value
+**
+** Parameters:  a CircularList and cursor
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the cursor is valid unless the list is empty
+**
+**
+*******************************************************************/
+void circularListCursorBegin(struct CircularList* list, struct CircularListCursor* cursor)
+{
+    assert(list!=0 && cursor!=0);
+    cursor->list = list;
+    cursor->link = 0;
+    cursor->index = 0;
+}
+
+/*********************************************************************
+** Function: circularListCursorLast
+** Description: puts a cursor on the back value, for walking the list
+**              back to front with circularListCursorPrev
+**
+** Parameters:  a CircularList and cursor
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the cursor is valid unless the list is empty
+**
+**
+*******************************************************************/
+void circularListCursorLast(struct CircularList* list, struct CircularListCursor* cursor)
+{
+    assert(list!=0 && cursor!=0);
+    cursor->list = list;
+    cursor->link = 0;
+    cursor->index = list->size - 1;
+}
+
+/*********************************************************************
+** Function: circularListCursorValid
+** Description: returns 1 if the cursor is on a value and 0 once it
+**              has moved past either end
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor has been placed by Begin or Last
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+int circularListCursorValid(struct CircularListCursor* cursor)
+{
+    assert(cursor!=0);
+    return cursor->index >= 0 && cursor->index < cursor->list->size;
+}
+
+/*********************************************************************
+** Function: circularListCursorNext
+** Description: moves the cursor one value toward the back
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor is valid
+** Post-Conditions: the cursor is on the next value or past the back
+**
+**
+*******************************************************************/
+void circularListCursorNext(struct CircularListCursor* cursor)
+{
+    assert(circularListCursorValid(cursor));
+    cursor->index++;
+}
+
+/*********************************************************************
+** Function: circularListCursorPrev
+** Description: moves the cursor one value toward the front
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor is valid
+** Post-Conditions: the cursor is on the previous value or past the
+**                  front
+**
+**
+*******************************************************************/
+void circularListCursorPrev(struct CircularListCursor* cursor)
+{
+    assert(circularListCursorValid(cursor));
+    cursor->index--;
+}
+
+/*********************************************************************
+** Function: circularListCursorGet
+** Description: returns the value under the cursor
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor is valid
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+TYPE circularListCursorGet(struct CircularListCursor* cursor)
+{
+    assert(circularListCursorValid(cursor));
+    struct CircularList * list = cursor->list;
+    return *slotAt(list, list->reversed ? list->size - 1 - cursor->index : cursor->index);
+}
+
+/*********************************************************************
+** Function: circularListCursorRemove
+** Description: removes the value under the cursor by moving every
+**              value between it and the nearer end over by one, and
+**              leaves the cursor on the value that followed it
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor is valid
+** Post-Conditions: the value is gone, the cursor is on the next value
+**                  or past the back
+**
+**
+*******************************************************************/
+void circularListCursorRemove(struct CircularListCursor* cursor)
+{
+    assert(circularListCursorValid(cursor));
+    struct CircularList * list = cursor->list;
+    int index = list->reversed ? list->size - 1 - cursor->index : cursor->index;
+
+    if(index < list->size / 2){
+        for(int i = index; i > 0; i--) *slotAt(list, i) = *slotAt(list, i - 1);
+        removeFront(list);
+    }
+    else {
+        for(int i = index; i < list->size - 1; i++) *slotAt(list, i) = *slotAt(list, i + 1);
+        removeBack(list);
+    }
+    // every later value moved up one place, so index already names the
+    // one that followed
+}
+
+/*********************************************************************
+** Function: circularListForEach
+** Description: calls visit on every value front to back until visit
+**              returns 0
+**
+** Parameters:  a CircularList, the visitor and an argument passed to
+**              it
+**
+** Pre-Conditions: the list has been initialized, visit does not
+**                 change the list
+** Post-Conditions: returns how many values were visited
+**
+**
+*******************************************************************/
+int circularListForEach(struct CircularList* list, int (*visit)(TYPE value, void* arg), void* arg)
+{
+    assert(list!=0 && visit!=0);
+
+    int visited = 0;
+    if(list->reversed){
+        for(int i = list->size - 1; i >= 0; i--){
+            visited++;
+            if(!visit(*slotAt(list, i), arg)) break;
+        }
+        STAT_ADD(list, traversed, visited);
+        return visited;
+    }
+
+    // a run at a time, values within a block are contiguous
+    for(int i = 0; i < list->size; i += runLength(list, i)){
+        TYPE * values = slotAt(list, i);
+        int count = runLength(list, i);
+        for(int j = 0; j < count; j++){
+            visited++;
+            if(!visit(values[j], arg)){
+                STAT_ADD(list, traversed, visited);
+                return visited;
+            }
+        }
+    }
+    STAT_ADD(list, traversed, visited);
+    return visited;
+}
+
+/*********************************************************************
+** Function: circularListRemoveIf
+** Description: removes every value match returns nonzero for in one
+**              pass, sliding the kept values together and freeing the
+**              blocks left empty at the back
+**
+** Parameters:  a CircularList, the predicate and an argument passed
+**              to it
+**
+** Pre-Conditions: the list has been initialized, match does not
+**                 change the list
+** Post-Conditions: returns how many values were removed
+**
+**
+*******************************************************************/
+int circularListRemoveIf(struct CircularList* list, int (*match)(TYPE value, void* arg), void* arg)
+{
+    assert(list!=0 && match!=0);
+
+    // the kept values keep their storage order, which is right whether
+    // or not the list is reversed
+    int kept = 0;
+    for(int i = 0; i < list->size; i++){
+        TYPE value = *slotAt(list, i);
+        if(!match(value, arg)) *slotAt(list, kept++) = value;
+    }
+    STAT_ADD(list, traversed, list->size);
+
+    int removed = list->size - kept;
+    while(list->size > kept) removeBack(list);
+    return removed;
+}
+
+/*********************************************************************
+** Function: circularListConcat
+** Description: moves every value of other onto the back of list,
+**              leaving other empty; the values are copied
+**
+** Parameters:  two CircularLists
+**
+** Pre-Conditions: the lists are different
+** Post-Conditions: other is empty
+**
+**
+*******************************************************************/
+void circularListConcat(struct CircularList* list, struct CircularList* other)
+{
+    assert(list!=0 && other!=0 && list!=other);
+    moveValues(other, other->size, 0, other->size, list, list->size, list->size);
+}
+
+/*********************************************************************
+** Function: circularListSplice
+** Description: moves the values from first through last, both
+**              included, in front of position in another list
+**
+** Parameters:  a cursor on the value to insert before, or past the
+**              back to append, and cursors on the first and last
+**              value to move
+**
+** Pre-Conditions: first and last are valid cursors of one list, last
+**                 is not before first, position is on another list
+** Post-Conditions: position is still on the same value; first and
+**                  last are not valid any more
+**
+*******************************************************************/
+void circularListSplice(struct CircularListCursor* position, struct CircularListCursor* first,
+                        struct CircularListCursor* last)
+{
+    assert(position!=0 && position->index>=0 && position->index<=position->list->size);
+    assert(circularListCursorValid(first) && circularListCursorValid(last));
+    assert(first->list==last->list && first->list!=position->list);
+    assert(first->index<=last->index);
+
+    int count = last->index - first->index + 1;
+    moveValues(first->list, first->list->size, first->index, count,
+               position->list, position->list->size, position->index);
+    position->index += count;
+}
+
+/*********************************************************************
+** Function: circularListSplit
+** Description: moves the value under the cursor and every value after
+**              it onto the back of other
+**
+** Parameters:  a cursor and the list to move the values to
+**
+** Pre-Conditions: the cursor is valid, other is another list
+** Post-Conditions: the cursor's list ends just before where the
+**                  cursor was, the cursor is past its back
+**
+*******************************************************************/
+void circularListSplit(struct CircularListCursor* cursor, struct CircularList* other)
+{
+    assert(circularListCursorValid(cursor));
+    struct CircularList * list = cursor->list;
+    assert(other!=0 && other!=list);
+
+    moveValues(list, list->size, cursor->index, list->size - cursor->index, other, other->size, other->size);
+    cursor->index = list->size;
+}
+
+/*********************************************************************
+** Function: valueAt
+** Description: returns the address of the value the given distance
+**              from the front, for the ordering in circularListSort.h
+**
+** Parameters:  a CircularList and index
+**
+** Pre-Conditions: 0 <= index < size
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+static TYPE* valueAt(struct CircularList* list, int index)
+{
+    return slotAt(list, list->reversed ? list->size - 1 - index : index);
+}
+
+/*********************************************************************
+** Function: circularListSort
+** Description: sorts the list by LT in place with the stable merge
+**              sort from circularListSort.h: insertion sorted runs
+**              merged by rotation, in O(n log^2 n). Values are only
+**              swapped between slots, nothing is allocated. A lazily
+**              reversed list is sorted front to back and stays
+**              reversed
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the list is in order, equal values in the order
+**                  they were in before
+**
+*******************************************************************/
+void circularListSort(struct CircularList* list)
+{
+    assert(list!=0);
+    sortSlots(list, valueAt, list->size);
+    STAT_ADD(list, traversed, list->size);
+}
+
+/*********************************************************************
+** Function: circularListAddSorted
+** Description: adds a value after every value not greater than it,
+**              found with a binary search, then moves the shorter
+**              side of the list over by one. Only the end it grows
+**              can allocate, when that end needs a new block
+**
+** Parameters:  a CircularList and value
+**
+** Pre-Conditions: the list is sorted by LT
+** Post-Conditions: the list is still sorted, the value after any
+**                  equal values
+**
+*******************************************************************/
+void circularListAddSorted(struct CircularList* list, TYPE value)
+{
+    assert(list!=0);
+    addSortedSlots(list, valueAt, list->size, value);
+}
+
+/*********************************************************************
+** Function: circularListMerge
+** Description: merges every value of other into list in O(n+m) with
+**              the deque calls alone, leaving other empty. Blocks
+**              emptied at list's front are reused at its back, so
+**              only the blocks list grows by are allocated
+**
+** Parameters:  two CircularLists
+**
+** Pre-Conditions: the lists are different and both sorted by LT
+** Post-Conditions: list is sorted, values equal to one of list's come
+**                  after it, other is empty
+**
+*******************************************************************/
+void circularListMerge(struct CircularList* list, struct CircularList* other)
+{
+    assert(list!=0 && other!=0 && list!=other);
+    mergeSorted(list, list->size, other);
+}
+
+/*********************************************************************
+** Function: circularListStats
+** Description: copies the list's instrumentation counters; every
+**              counter reads 0 unless the list was built with
+**              CS261_STATS defined
+**
+** Parameters:  a CircularList and where to copy the counters
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: stats holds the counters since the last reset
+**
+**
+*******************************************************************/
+void circularListStats(struct CircularList* list, struct CircularListStats* stats)
+{
+    assert(list!=0 && stats!=0);
+#ifdef CS261_STATS
+    *stats = list->stats;
+#else
+    stats->allocations = 0;
+    stats->frees = 0;
+    stats->traversed = 0;
+    stats->peakSize = 0;
+#endif
+}
+
+/*********************************************************************
+** Function: circularListStatsReset
+** Description: zeroes the list's instrumentation counters, the peak
+**              size starts over from the current size
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the counters read 0
+**
+**
+*******************************************************************/
+void circularListStatsReset(struct CircularList* list)
+{
+    assert(list!=0);
+#ifdef CS261_STATS
+    list->stats.allocations = 0;
+    list->stats.frees = 0;
+    list->stats.traversed = 0;
+    list->stats.peakSize = list->size;
+#endif
+}
+
+/*********************************************************************
+** Function: circularListStatsPrint
+** Description: prints the list's instrumentation counters as one line
+**              of JSON
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the counters have been printed
+**
+**
+*******************************************************************/
+void circularListStatsPrint(struct CircularList* list)
+{
+    struct CircularListStats stats;
+    circularListStats(list, &stats);
+    printf("{\"structure\": \"CircularListBlocks\", \"allocations\": %lu, \"frees\": %lu, "
+           "\"traversed\": %lu, \"peak_size\": %d}\n",
+           stats.allocations, stats.frees, stats.traversed, stats.peakSize);
+}
@@ -0,0 +1,1592 @@
+/***********************************************************
+* Filename:                     circularFileList.c
+*
+* Overview:
+*   This file contains a file backed implementation of the
+*   CircularList deque declared in circularList.h. Values live
+*   in a power of two ring inside a shared memory mapping of a
+*   file, after a header page holding the ring's head, size and
+*   capacity. Every change writes its values first and then
+*   commits with one store to the header, so a list reopened with
+*   circularListOpen after a crash holds every operation that
+*   completed. Changes that move values around, like RemoveIf,
+*   are written into the free slots after the tail and switched
+*   to in that one store. The ring grows by extending the file
+*   and mapping it again. How often the mapping is flushed to
+*   disk is up to the caller, see circularListSync and
+*   circularListSyncEvery. circularListCreate maps an unlinked
+*   temporary file. Link against this file instead of
+*   circularList.c to use it.
+*
+*
+* Input:
+*   No input is required.
+*
+* Output:
+*   No output
+************************************************************/
+
+// pread, ftruncate, mkstemp and mmap are POSIX, not C99
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "circularFileList.h"
+#include "circularListScan.h"
+#include "circularListMove.h"
+#include "circularListSort.h"
+
+#define FILE_MAGIC "CS261CF"
+
+// Values start one header page into the file
+#define HEADER_SIZE 4096
+
+// Values in a new ring, must be a power of two
+#ifndef INITIAL_CAPACITY
+#define INITIAL_CAPACITY 1024
+#endif
+
+// Instrumentation counters, compiled out unless CS261_STATS is defined
+#ifdef CS261_STATS
+#define STAT_ADD(list, counter, n) ((list)->stats.counter += (n))
+#define STAT_PEAK(list) \
+    do { if(size(list) > (list)->stats.peakSize) (list)->stats.peakSize = size(list); } while(0)
+#else
+#define STAT_ADD(list, counter, n) ((void)0)
+#define STAT_PEAK(list) ((void)0)
+#endif
+
+// Header words are each published with one store, ordered after the
+// values they cover, so a crash sees a word either before or after an
+// operation and never a value the header does not hold yet
+#ifdef __GNUC__
+#define PUBLISH(word, value) __atomic_store_n(&(word), (uint64_t)(value), __ATOMIC_RELEASE)
+#else
+#define PUBLISH(word, value) (*(volatile uint64_t*)&(word) = (uint64_t)(value))
+#endif
+
+// First page of the file. The ring holds values[head .. head+size-1],
+// wrapping at capacity, with head in the low 32 bits of ring and size
+// in the high 32 bits so one store moves both; reversed makes the back
+// of the ring the front.
+struct FileHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t valueSize;
+	uint64_t capacity;
+	uint64_t ring;
+	uint64_t reversed;
+};
+
+// Largest ring, head and size must fit in 32 bits
+#define MAX_CAPACITY ((uint64_t)1 << 31)
+
+struct CircularList
+{
+	int fd;
+	struct FileHeader* header;	// start of the mapping
+	TYPE* values;
+	size_t mapLength;
+
+	// start of the values being written after the tail, see stageRing
+	uint64_t stage;
+
+	// msync after this many changes, never when 0
+	int syncEvery;
+	int changes;
+
+#ifdef CS261_STATS
+	struct CircularListStats stats;
+#endif
+};
+
+
+/*********************************************************************
+** Function: head
+**
+** Description: returns the ring position of the value at the head
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: NONE
+********************************************************************/
+static uint64_t head(struct CircularList* list)
+{
+    return list->header->ring & 0xffffffffu;
+}
+
+/*********************************************************************
+** Function: size
+**
+** Description: returns how many values the ring holds
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: NONE
+********************************************************************/
+static int size(struct CircularList* list)
+{
+    return (int)(list->header->ring >> 32);
+}
+
+/*********************************************************************
+** Function: mask
+**
+** Description: returns the mask that wraps a position into the ring
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: NONE
+********************************************************************/
+static uint64_t mask(struct CircularList* list)
+{
+    return list->header->capacity - 1;
+}
+
+/*********************************************************************
+** Function: publishRing
+**
+** Description: commits a new head and size with a single store
+**
+** Parameters:  a CircularList, the ring position of the front and the
+**              number of values from there on
+**
+** Pre-Conditions:  every value the new ring covers is in place
+** Post-Conditions: the ring is values[head .. head+size-1]
+********************************************************************/
+static void publishRing(struct CircularList* list, uint64_t head, int size)
+{
+    PUBLISH(list->header->ring, (uint64_t)size << 32 | (head & mask(list)));
+}
+
+/*********************************************************************
+** Function: slotAt
+**
+** Description: returns the address of the value the given distance
+**              from the head of the ring
+**
+** Parameters:  a CircularList and index
+**
+** Pre-Conditions:  0 <= index < size
+** Post-Conditions: NONE
+********************************************************************/
+static TYPE* slotAt(struct CircularList* list, int index)
+{
+    return &list->values[(head(list) + index) & mask(list)];
+}
+
+/*********************************************************************
+** Function: runLength
+**
+** Description: returns how many values from the given index on sit
+**              before the ring wraps
+**
+** Parameters:  a CircularList and index
+**
+** Pre-Conditions:  0 <= index < size
+** Post-Conditions: NONE
+********************************************************************/
+static int runLength(struct CircularList* list, int index)
+{
+    int room = (int)(list->header->capacity - ((head(list) + index) & mask(list)));
+    return size(list) - index < room ? size(list) - index : room;
+}
+
+/*********************************************************************
+** Function: mapFile
+**
+** Description: maps the header page and a ring of capacity values,
+**              extending the file first if it is too short
+**
+** Parameters:  a CircularList with its file open and a capacity
+**
+** Pre-Conditions:  any earlier mapping has been unmapped
+** Post-Conditions: returns 0, or -1 with errno set
+********************************************************************/
+static int mapFile(struct CircularList* list, uint64_t capacity)
+{
+    size_t length = HEADER_SIZE + capacity * sizeof(TYPE);
+    struct stat status;
+    if(fstat(list->fd, &status) != 0) return -1;
+    if((size_t)status.st_size < length && ftruncate(list->fd, (off_t)length) != 0) return -1;
+
+    void* map = mmap(0, length, PROT_READ | PROT_WRITE, MAP_SHARED, list->fd, 0);
+    if(map == MAP_FAILED) return -1;
+    STAT_ADD(list, allocations, 1);
+    list->header = map;
+    list->values = (TYPE*)((char*)map + HEADER_SIZE);
+    list->mapLength = length;
+    return 0;
+}
+
+/*********************************************************************
+** Function: fail
+**
+** Description: reports a system call that failed where the deque
+**              interface has no way to return the error, and aborts
+**
+** Parameters:  what was being done, errno still holds the reason
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: does not return
+********************************************************************/
+static void fail(const char* what)
+{
+    fprintf(stderr, "circularFileList: %s: %s\n", what, strerror(errno));
+    abort();
+}
+
+/*********************************************************************
+** Function: growRing
+**
+** Description: doubles the ring, moving the values that wrapped past
+**              the old end to just after it. The header only takes the
+**              new capacity once they are copied, so a crash part way
+**              leaves the old ring intact. The bigger ring is mapped
+**              before the old one goes, and if the file cannot be
+**              extended or mapped the program aborts with the reason,
+**              since the adds that grow the ring return nothing
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions:  the ring is below MAX_CAPACITY
+** Post-Conditions: capacity has doubled
+********************************************************************/
+static void growRing(struct CircularList* list)
+{
+    uint64_t capacity = list->header->capacity;
+    assert(capacity < MAX_CAPACITY);
+    void* old = list->header;
+    size_t oldLength = list->mapLength;
+    if(mapFile(list, capacity * 2) != 0) fail("cannot grow the ring file");
+    if(munmap(old, oldLength) != 0) fail("cannot unmap the old ring");
+    STAT_ADD(list, frees, 1);
+
+    if(head(list) + size(list) > capacity){
+        memcpy(list->values + capacity, list->values, (head(list) + size(list) - capacity) * sizeof(TYPE));
+    }
+    PUBLISH(list->header->capacity, capacity * 2);
+}
+
+/*********************************************************************
+** Function: reserve
+**
+** Description: grows the ring until count more values fit after the
+**              tail
+**
+** Parameters:  a CircularList and number of values
+**
+** Pre-Conditions:  count >= 0
+** Post-Conditions: at least count slots are free
+********************************************************************/
+static void reserve(struct CircularList* list, int count)
+{
+    while(list->header->capacity - size(list) < (uint64_t)count) growRing(list);
+}
+
+/*********************************************************************
+** Function: stageRing
+**
+** Description: starts a rewrite of the whole list into the free slots
+**              after the tail, where a crash cannot disturb the values
+**              the header still covers; stagedAt addresses the new
+**              values and publishRing from list->stage switches over
+**
+** Parameters:  a CircularList and how many values the rewrite holds
+**
+** Pre-Conditions:  count >= 0
+** Post-Conditions: the count slots from list->stage are free
+********************************************************************/
+static void stageRing(struct CircularList* list, int count)
+{
+    reserve(list, size(list) + count);
+    list->stage = head(list) + size(list);
+}
+
+/*********************************************************************
+** Function: stagedAt
+**
+** Description: returns the address of a value of the rewrite started
+**              by stageRing, counted in stored order
+**
+** Parameters:  a CircularList and index
+**
+** Pre-Conditions:  stageRing reserved more than index slots
+** Post-Conditions: NONE
+********************************************************************/
+static TYPE* stagedAt(struct CircularList* list, int index)
+{
+    return &list->values[(list->stage + index) & mask(list)];
+}
+
+/*********************************************************************
+** Function: changed
+**
+** Description: counts a change toward the sync policy
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: the mapping has been synced if the policy says so,
+**                  aborts if that sync fails
+********************************************************************/
+static void changed(struct CircularList* list)
+{
+    if(list->syncEvery > 0 && ++list->changes >= list->syncEvery){
+        if(circularListSync(list) != 0) fail("cannot sync the ring file");
+    }
+}
+
+/* Ring operations on the stored order, the public functions map the
+   front and back onto them through reversed. Each writes the values
+   first and then publishes the ring once, so a run of count values
+   lands in a crash all together or not at all. */
+
+/*********************************************************************
+** Function: addHead
+**
+** Description: adds values in front of the head of the ring
+**
+** Parameters:  a CircularList, the values, how many, and whether they
+**              go in last to first
+**
+** Pre-Conditions:  count >= 0
+** Post-Conditions: the values are at the head, in the order given or
+**                  backwards
+********************************************************************/
+static void addHead(struct CircularList* list, const TYPE* values, int count, int backwards)
+{
+    reserve(list, count);
+    uint64_t first = head(list) - count;
+    for(int i = 0; i < count; i++){
+        list->values[(first + (backwards ? count - 1 - i : i)) & mask(list)] = values[i];
+    }
+    publishRing(list, first, size(list) + count);
+    STAT_PEAK(list);
+}
+
+/*********************************************************************
+** Function: addTail
+**
+** Description: adds values after the tail of the ring
+**
+** Parameters:  a CircularList, the values, how many, and whether they
+**              go in last to first
+**
+** Pre-Conditions:  count >= 0
+** Post-Conditions: the values are at the tail, in the order given or
+**                  backwards
+********************************************************************/
+static void addTail(struct CircularList* list, const TYPE* values, int count, int backwards)
+{
+    reserve(list, count);
+    uint64_t tail = head(list) + size(list);
+    for(int i = 0; i < count; i++){
+        list->values[(tail + (backwards ? count - 1 - i : i)) & mask(list)] = values[i];
+    }
+    publishRing(list, head(list), size(list) + count);
+    STAT_PEAK(list);
+}
+
+/*********************************************************************
+** Function: removeHead
+**
+** Description: removes values from the head of the ring by publishing
+**              the head past them
+**
+** Parameters:  a CircularList and how many
+**
+** Pre-Conditions:  0 <= count <= size
+** Post-Conditions: the values are no longer in the ring
+********************************************************************/
+static void removeHead(struct CircularList* list, int count)
+{
+    publishRing(list, head(list) + count, size(list) - count);
+}
+
+/*********************************************************************
+** Function: removeTail
+**
+** Description: removes values from the tail of the ring by publishing
+**              the smaller size
+**
+** Parameters:  a CircularList and how many
+**
+** Pre-Conditions:  0 <= count <= size
+** Post-Conditions: the values are no longer in the ring
+********************************************************************/
+static void removeTail(struct CircularList* list, int count)
+{
+    publishRing(list, head(list), size(list) - count);
+}
+
+/*********************************************************************
+** Function: openList
+**
+** Description: maps the file behind fd, adopting the ring already in
+**              it or starting an empty one in a new file
+**
+** Parameters:  an open file descriptor
+**
+** Pre-Conditions:  fd is open for reading and writing
+** Post-Conditions: returns the list, or null with errno set and fd
+**                  closed; EINVAL means the file holds something else
+********************************************************************/
+static struct CircularList* openList(int fd)
+{
+    struct CircularList* list = malloc(sizeof(struct CircularList));
+    assert(list!=0);
+    list->fd = fd;
+    list->syncEvery = 0;
+    list->changes = 0;
+#ifdef CS261_STATS
+    memset(&list->stats, 0, sizeof(list->stats));
+#endif
+
+    struct stat status;
+    int error = 0;
+    if(fstat(fd, &status) != 0) error = errno;
+    else if(status.st_size == 0){
+        if(mapFile(list, INITIAL_CAPACITY) != 0) error = errno;
+        else {
+            memset(list->header, 0, sizeof(struct FileHeader));
+            list->header->version = CIRCULAR_FILE_LIST_VERSION;
+            list->header->valueSize = sizeof(TYPE);
+            list->header->capacity = INITIAL_CAPACITY;
+            // the magic goes in last, a file without it is not a list yet
+            memcpy(list->header->magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        }
+    }
+    else {
+        struct FileHeader header;
+        if(pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)
+           || memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0
+           || header.version != CIRCULAR_FILE_LIST_VERSION
+           || header.valueSize != sizeof(TYPE)
+           || header.capacity == 0 || header.capacity > MAX_CAPACITY
+           || (header.capacity & (header.capacity - 1)) != 0
+           || (header.ring >> 32) > header.capacity || (header.ring & 0xffffffffu) >= header.capacity
+           || header.reversed > 1
+           || (uint64_t)status.st_size < HEADER_SIZE + header.capacity * sizeof(TYPE)){
+            error = EINVAL;
+        }
+        else if(mapFile(list, header.capacity) != 0) error = errno;
+    }
+
+    if(error != 0){
+        close(fd);
+        free(list);
+        errno = error;
+        return 0;
+    }
+    return list;
+}
+
+/*********************************************************************
+** Function: circularListOpen
+**
+** Description: opens the list kept in the file at path, creating an
+**              empty one if the file does not exist
+**
+** Parameters:  a file path
+**
+** Pre-Conditions:  no other list has the file open
+** Post-Conditions: returns the list, or null with errno set
+********************************************************************/
+struct CircularList* circularListOpen(const char* path)
+{
+    assert(path!=0);
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if(fd < 0) return 0;
+    return openList(fd);
+}
+
+/*********************************************************************
+** Function: circularListCreate
+**
+** Description: allocates an empty list backed by a temporary file
+**              that is unlinked at once, so it vanishes with the list
+**
+** Parameters:  NONE
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: returns the list, or null with errno set if the
+**                  file could not be made or mapped
+********************************************************************/
+struct CircularList* circularListCreate()
+{
+    const char* directory = getenv("TMPDIR");
+    char path[4096];
+    if(snprintf(path, sizeof(path), "%s/circularListXXXXXX", directory != 0 ? directory : "/tmp")
+       >= (int)sizeof(path)){
+        errno = ENAMETOOLONG;
+        return 0;
+    }
+    int fd = mkstemp(path);
+    if(fd < 0) return 0;
+    if(unlink(path) != 0){
+        int error = errno;
+        close(fd);
+        errno = error;
+        return 0;
+    }
+    return openList(fd);
+}
+
+/*********************************************************************
+** Function: circularListCreatePooled
+**
+** Description: same as circularListCreate, the ring is already one
+**              allocation
+**
+** Parameters:  NONE
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: returns the list
+********************************************************************/
+struct CircularList* circularListCreatePooled()
+{
+    return circularListCreate();
+}
+
+/*********************************************************************
+** Function: circularListDestroy
+**
+** Description: syncs the mapping if the list has a sync policy, then
+**              unmaps and closes the file; the file itself is kept
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: the list has been freed, aborts if the sync or
+**                  unmapping fails
+********************************************************************/
+void circularListDestroy(struct CircularList* list)
+{
+    assert(list!=0);
+    if(list->syncEvery > 0 && circularListSync(list) != 0) fail("cannot sync the ring file");
+    if(munmap(list->header, list->mapLength) != 0) fail("cannot unmap the ring");
+    if(close(list->fd) != 0) fail("cannot close the ring file");
+    free(list);
+}
+
+/*********************************************************************
+** Function: circularListSync
+**
+** Description: flushes the mapping to disk and waits for it
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: returns 0, or -1 with errno set
+********************************************************************/
+int circularListSync(struct CircularList* list)
+{
+    assert(list!=0);
+    list->changes = 0;
+    return msync(list->header, list->mapLength, MS_SYNC);
+}
+
+/*********************************************************************
+** Function: circularListSyncEvery
+**
+** Description: sets how many changes may pass between syncs, so a
+**              caller can trade throughput for how much a machine
+**              crash can lose; 0 leaves syncing to circularListSync
+**
+** Parameters:  a CircularList and number of changes
+**
+** Pre-Conditions:  operations is not negative
+** Post-Conditions: NONE
+********************************************************************/
+void circularListSyncEvery(struct CircularList* list, int operations)
+{
+    assert(list!=0 && operations>=0);
+    list->syncEvery = operations;
+    list->changes = 0;
+}
+
+// Deque interface
+
+/*********************************************************************
+** Function: circularListAddFront
+** Description: adds a value to the front of the deque
+**
+** Parameters:  a CircularList and Value
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the value passed is at the front
+**
+**
+*******************************************************************/
+void circularListAddFront(struct CircularList* list, TYPE value)
+{
+    assert(list!=0);
+    if(list->header->reversed) addTail(list, &value, 1, 0);
+    else addHead(list, &value, 1, 0);
+    changed(list);
+}
+
+/*********************************************************************
+** Function: circularListAddBack
+** Description: adds a value to the back of the deque
+**
+** Parameters:  a CircularList and Value
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the value passed is at the back
+**
+**
+*******************************************************************/
+void circularListAddBack(struct CircularList* list, TYPE value)
+{
+    assert(list!=0);
+    if(list->header->reversed) addHead(list, &value, 1, 0);
+    else addTail(list, &value, 1, 0);
+    changed(list);
+}
+
+/*********************************************************************
+** Function: circularListFront
+** Description: returns the value at the front of the circularList
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized and is not empty
+** Post-Conditions: the first value has been returned
+**
+**
+*******************************************************************/
+TYPE circularListFront(struct CircularList* list)
+{
+    assert(list!=0 && size(list)>0);
+    return *slotAt(list, list->header->reversed ? size(list) - 1 : 0);
+}
+
+/*********************************************************************
+** Function: circularListBack
+** Description: returns the value at the back of the circularList
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized and is not empty
+** Post-Conditions: the last value has been returned
+**
+**
+*******************************************************************/
+TYPE circularListBack(struct CircularList* list)
+{
+    assert(list!=0 && size(list)>0);
+    return *slotAt(list, list->header->reversed ? 0 : size(list) - 1);
+}
+
+/*********************************************************************
+** Function: circularListGet
+** Description: returns the value at the given index from the front,
+**              straight from the ring
+**
+** Parameters:  a CircularList and index
+**
+** Pre-Conditions: 0 <= index < size
+** Post-Conditions: the value at index has been returned
+**
+**
+*******************************************************************/
+TYPE circularListGet(struct CircularList* list, int index)
+{
+    assert(list!=0);
+    assert(index>=0 && index<size(list));
+    STAT_ADD(list, traversed, 1);
+    return *slotAt(list, list->header->reversed ? size(list) - 1 - index : index);
+}
+
+/*********************************************************************
+** Function: circularListRemoveFront
+** Description: removes the value at the front of the circularList
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized and is not empty
+** Post-Conditions: the first value has been removed
+**
+**
+*******************************************************************/
+void circularListRemoveFront(struct CircularList* list)
+{
+    assert(list!=0 && size(list)>0);
+    if(list->header->reversed) removeTail(list, 1);
+    else removeHead(list, 1);
+    changed(list);
+}
+
+/*********************************************************************
+** Function: circularListRemoveBack
+** Description: removes the value at the back of the circularList
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized and is not empty
+** Post-Conditions: the last value has been removed
+**
+**
+*******************************************************************/
+void circularListRemoveBack(struct CircularList* list)
+{
+    assert(list!=0 && size(list)>0);
+    if(list->header->reversed) removeHead(list, 1);
+    else removeTail(list, 1);
+    changed(list);
+}
+
+/*********************************************************************
+** Function: circularListIsEmpty
+** Description: returns 1 if the list holds no values and 0 if it does
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+int circularListIsEmpty(struct CircularList* list)
+{
+    assert(list!=0);
+    return size(list) == 0;
+}
+
+// Bulk interface, a bulk call publishes the ring once, so a crash
+// keeps all of its values or none, and counts as one change for the
+// sync policy
+
+/*********************************************************************
+** Function: circularListAddFrontArray
+** Description: adds count values to the front of the deque, keeping
+**              their array order, with one header store for all of
+**              them
+**
+** Parameters:  a CircularList, array of values and number of values
+**
+** Pre-Conditions: the list has been initialized, values holds count
+**                 values
+** Post-Conditions: the values are at the front, values[0] first
+**
+**
+*******************************************************************/
+void circularListAddFrontArray(struct CircularList* list, const TYPE* values, int count)
+{
+    assert(list!=0 && count>=0);
+    if(list->header->reversed) addTail(list, values, count, 1);
+    else addHead(list, values, count, 0);
+    changed(list);
+}
+
+/*********************************************************************
+** Function: circularListAddBackArray
+** Description: adds count values to the back of the deque in array
+**              order, with one header store for all of them
+**
+** Parameters:  a CircularList, array of values and number of values
+**
+** Pre-Conditions: the list has been initialized, values holds count
+**                 values
+** Post-Conditions: the values are at the back, values[count-1] last
+**
+**
+*******************************************************************/
+void circularListAddBackArray(struct CircularList* list, const TYPE* values, int count)
+{
+    assert(list!=0 && count>=0);
+    if(list->header->reversed) addHead(list, values, count, 1);
+    else addTail(list, values, count, 0);
+    changed(list);
+}
+
+/*********************************************************************
+** Function: circularListRemoveFrontArray
+** Description: removes up to count values from the front, copying
+**              them front to back into out before one header store
+**              removes them all
+**
+** Parameters:  a CircularList, output array and maximum number to
+**              remove
+**
+** Pre-Conditions: the list has been initialized, out has room for
+**                 count values
+** Post-Conditions: returns how many values were removed
+**
+**
+*******************************************************************/
+int circularListRemoveFrontArray(struct CircularList* list, TYPE* out, int count)
+{
+    assert(list!=0);
+    if(count > size(list)) count = size(list);
+    for(int i = 0; i < count; i++){
+        out[i] = *slotAt(list, list->header->reversed ? size(list) - 1 - i : i);
+    }
+    if(list->header->reversed) removeTail(list, count);
+    else removeHead(list, count);
+    changed(list);
+    return count;
+}
+
+/*********************************************************************
+** Function: circularListRemoveBackArray
+** Description: removes up to count values from the back, copying them
+**              into out in the order they are removed, back first,
+**              before one header store removes them all
+**
+** Parameters:  a CircularList, output array and maximum number to
+**              remove
+**
+** Pre-Conditions: the list has been initialized, out has room for
+**                 count values
+** Post-Conditions: returns how many values were removed
+**
+**
+*******************************************************************/
+int circularListRemoveBackArray(struct CircularList* list, TYPE* out, int count)
+{
+    assert(list!=0);
+    if(count > size(list)) count = size(list);
+    for(int i = 0; i < count; i++){
+        out[i] = *slotAt(list, list->header->reversed ? i : size(list) - 1 - i);
+    }
+    if(list->header->reversed) removeHead(list, count);
+    else removeTail(list, count);
+    changed(list);
+    return count;
+}
+
+/*********************************************************************
+** Function: circularListDrain
+** Description: removes every value, copying them front to back into
+**              out
+**
+** Parameters:  a CircularList and output array
+**
+** Pre-Conditions: the list has been initialized, out has room for
+**                 every value in the list
+** Post-Conditions: the list is empty, returns how many values were
+**                  removed
+**
+**
+*******************************************************************/
+int circularListDrain(struct CircularList* list, TYPE* out)
+{
+    assert(list!=0);
+    return circularListRemoveFrontArray(list, out, size(list));
+}
+
+/*********************************************************************
+** Function: circularListPrint
+** Description: prints each value in the list front to back
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the list of values has been printed
+**
+**
+*******************************************************************/
+void circularListPrint(struct CircularList* list)
+{
+    assert(list!=0);
+    for(int i = 0; i < size(list); i++){
+        printf("%f ", *slotAt(list, list->header->reversed ? size(list) - 1 - i : i));
+    }
+    printf("\n");
+}
+
+/*********************************************************************
+** Function: circularListReverse
+** Description: reverses the list by writing the values back to front
+**              into the free slots after the tail and switching the
+**              ring over to them
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the list of values has been reversed
+**
+**
+*******************************************************************/
+void circularListReverse(struct CircularList* list)
+{
+    assert(list!=0);
+    int count = size(list);
+    stageRing(list, count);
+    for(int i = 0; i < count; i++) *stagedAt(list, i) = *slotAt(list, count - 1 - i);
+    publishRing(list, list->stage, count);
+    STAT_ADD(list, traversed, count);
+    changed(list);
+}
+
+/*********************************************************************
+** Function: circularListReverseLazy
+** Description: reverses the list in O(1) by flipping the header's
+**              reversed word, every deque operation honors it
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: front and back have traded places
+**
+**
+*******************************************************************/
+void circularListReverseLazy(struct CircularList* list)
+{
+    assert(list!=0);
+    PUBLISH(list->header->reversed, !list->header->reversed);
+    changed(list);
+}
+
+// Search interface, the ring is at most two runs of values
+
+/*********************************************************************
+** Function: circularListContains
+** Description: returns 1 if the list holds value and 0 if not
+**
+** Parameters:  a CircularList and value to look for
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+int circularListContains(struct CircularList* list, TYPE value)
+{
+    assert(list!=0);
+    for(int i = 0; i < size(list); i += runLength(list, i)){
+        if(findRun(slotAt(list, i), runLength(list, i), value) >= 0){
+            STAT_ADD(list, traversed, i + runLength(list, i));
+            return 1;
+        }
+    }
+    STAT_ADD(list, traversed, size(list));
+    return 0;
+}
+
+/*********************************************************************
+** Function: circularListFindIndex
+** Description: returns the index from the front of the first value
+**              equal to value; a reversed list is scanned from the
+**              back of the ring
+**
+** Parameters:  a CircularList and value to look for
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: returns the index, or -1 if the list does not hold
+**                  value
+**
+**
+*******************************************************************/
+int circularListFindIndex(struct CircularList* list, TYPE value)
+{
+    assert(list!=0);
+    if(!list->header->reversed){
+        for(int i = 0; i < size(list); i += runLength(list, i)){
+            int found = findRun(slotAt(list, i), runLength(list, i), value);
+            if(found >= 0){
+                STAT_ADD(list, traversed, i + found + 1);
+                return i + found;
+            }
+        }
+        STAT_ADD(list, traversed, size(list));
+        return -1;
+    }
+    for(int i = size(list) - 1; i >= 0; i--){
+        if(EQ(*slotAt(list, i), value)){
+            STAT_ADD(list, traversed, size(list) - i);
+            return size(list) - 1 - i;
+        }
+    }
+    STAT_ADD(list, traversed, size(list));
+    return -1;
+}
+
+/*********************************************************************
+** Function: circularListCount
+** Description: returns how many values equal value
+**
+** Parameters:  a CircularList and value to count
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+int circularListCount(struct CircularList* list, TYPE value)
+{
+    assert(list!=0);
+    int found = 0;
+    for(int i = 0; i < size(list); i += runLength(list, i)){
+        found += countRun(slotAt(list, i), runLength(list, i), value);
+    }
+    STAT_ADD(list, traversed, size(list));
+    return found;
+}
+
+/*********************************************************************
+** Function: circularListSum
+** Description: returns the sum of every value, added a run of the
+**              ring at a time in storage order, so a sum of doubles
+**              may round differently than a front to back loop
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: returns the sum, 0 for an empty list
+**
+**
+*******************************************************************/
+TYPE circularListSum(struct CircularList* list)
+{
+    assert(list!=0);
+    TYPE sum = 0;
+    for(int i = 0; i < size(list); i += runLength(list, i)){
+        sum += sumRun(slotAt(list, i), runLength(list, i));
+    }
+    STAT_ADD(list, traversed, size(list));
+    return sum;
+}
+
+/*********************************************************************
+** Function: circularListMin
+** Description: returns the smallest value in the list
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized and is not empty
+** Post-Conditions: returns the smallest value
+**
+**
+*******************************************************************/
+TYPE circularListMin(struct CircularList* list)
+{
+    assert(list!=0 && size(list)>0);
+    TYPE min = *slotAt(list, 0);
+    for(int i = 0; i < size(list); i += runLength(list, i)){
+        TYPE run = minRun(slotAt(list, i), runLength(list, i));
+        if(LT(run, min)) min = run;
+    }
+    STAT_ADD(list, traversed, size(list));
+    return min;
+}
+
+/*********************************************************************
+** Function: circularListMax
+** Description: returns the largest value in the list
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized and is not empty
+** Post-Conditions: returns the largest value
+**
+**
+*******************************************************************/
+TYPE circularListMax(struct CircularList* list)
+{
+    assert(list!=0 && size(list)>0);
+    TYPE max = *slotAt(list, 0);
+    for(int i = 0; i < size(list); i += runLength(list, i)){
+        TYPE run = maxRun(slotAt(list, i), runLength(list, i));
+        if(LT(max, run)) max = run;
+    }
+    STAT_ADD(list, traversed, size(list));
+    return max;
+}
+
+// Cursor interface, cursors hold an index from the front
+
+/*********************************************************************
+** Function: circularListCursorBegin
+** Description: puts a cursor on the front value
+**
+** Parameters:  a CircularList and cursor
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the cursor is valid unless the list is empty
+**
+**
+*******************************************************************/
+void circularListCursorBegin(struct CircularList* list, struct CircularListCursor* cursor)
+{
+    assert(list!=0 && cursor!=0);
+    cursor->list = list;
+    cursor->link = 0;
+    cursor->index = 0;
+}
+
+/*********************************************************************
+** Function: circularListCursorLast
+** Description: puts a cursor on the back value, for walking the list
+**              back to front with circularListCursorPrev
+**
+** Parameters:  a CircularList and cursor
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the cursor is valid unless the list is empty
+**
+**
+*******************************************************************/
+void circularListCursorLast(struct CircularList* list, struct CircularListCursor* cursor)
+{
+    assert(list!=0 && cursor!=0);
+    cursor->list = list;
+    cursor->link = 0;
+    cursor->index = size(list) - 1;
+}
+
+/*********************************************************************
+** Function: circularListCursorValid
+** Description: returns 1 if the cursor is on a value and 0 once it
+**              has moved past either end
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor has been placed by Begin or Last
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+int circularListCursorValid(struct CircularListCursor* cursor)
+{
+    assert(cursor!=0);
+    return cursor->index >= 0 && cursor->index < size(cursor->list);
+}
+
+/*********************************************************************
+** Function: circularListCursorNext
+** Description: moves the cursor one value toward the back
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor is valid
+** Post-Conditions: the cursor is on the next value or past the back
+**
+**
+*******************************************************************/
+void circularListCursorNext(struct CircularListCursor* cursor)
+{
+    assert(circularListCursorValid(cursor));
+    cursor->index++;
+}
+
+/*********************************************************************
+** Function: circularListCursorPrev
+** Description: moves the cursor one value toward the front
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor is valid
+** Post-Conditions: the cursor is on the previous value or past the
+**                  front
+**
+**
+*******************************************************************/
+void circularListCursorPrev(struct CircularListCursor* cursor)
+{
+    assert(circularListCursorValid(cursor));
+    cursor->index--;
+}
+
+/*********************************************************************
+** Function: circularListCursorGet
+** Description: returns the value under the cursor
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor is valid
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+TYPE circularListCursorGet(struct CircularListCursor* cursor)
+{
+    assert(circularListCursorValid(cursor));
+    return circularListGet(cursor->list, cursor->index);
+}
+
+/*********************************************************************
+** Function: circularListCursorRemove
+** Description: removes the value under the cursor and leaves the
+**              cursor on the value that followed it. A value at either
+**              end is published away in place; any other means writing
+**              the rest of the list into the free slots and switching
+**              over, so a crash never sees half a move
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor is valid
+** Post-Conditions: the value is gone, the cursor is on the next value
+**                  or past the back
+**
+**
+*******************************************************************/
+void circularListCursorRemove(struct CircularListCursor* cursor)
+{
+    assert(circularListCursorValid(cursor));
+    struct CircularList * list = cursor->list;
+    int index = list->header->reversed ? size(list) - 1 - cursor->index : cursor->index;
+    int count = size(list) - 1;
+
+    if(index == 0 || index == count){
+        if(index == 0) removeHead(list, 1);
+        else removeTail(list, 1);
+        changed(list);
+        return;
+    }
+
+    stageRing(list, count);
+    for(int i = 0; i < index; i++) *stagedAt(list, i) = *slotAt(list, i);
+    for(int i = index; i < count; i++) *stagedAt(list, i) = *slotAt(list, i + 1);
+    publishRing(list, list->stage, count);
+    STAT_ADD(list, traversed, count);
+    changed(list);
+}
+
+/*********************************************************************
+** Function: circularListForEach
+** Description: calls visit on every value front to back until visit
+**              returns 0
+**
+** Parameters:  a CircularList, the visitor and an argument passed to
+**              it
+**
+** Pre-Conditions: the list has been initialized, visit does not
+**                 change the list
+** Post-Conditions: returns how many values were visited
+**
+**
+*******************************************************************/
+int circularListForEach(struct CircularList* list, int (*visit)(TYPE value, void* arg), void* arg)
+{
+    assert(list!=0 && visit!=0);
+    int visited = 0;
+    while(visited < size(list)){
+        int i = visited++;
+        if(!visit(*slotAt(list, list->header->reversed ? size(list) - 1 - i : i), arg)) break;
+    }
+    STAT_ADD(list, traversed, visited);
+    return visited;
+}
+
+/*********************************************************************
+** Function: circularListRemoveIf
+** Description: removes every value match returns nonzero for in one
+**              pass, writing the kept values into the free slots
+**              after the tail and switching the ring over to them
+**              with one header store
+**
+** Parameters:  a CircularList, the predicate and an argument passed
+**              to it
+**
+** Pre-Conditions: the list has been initialized, match does not
+**                 change the list
+** Post-Conditions: returns how many values were removed
+**
+**
+*******************************************************************/
+int circularListRemoveIf(struct CircularList* list, int (*match)(TYPE value, void* arg), void* arg)
+{
+    assert(list!=0 && match!=0);
+
+    // the kept values keep their ring order, right whether or not the
+    // list is reversed
+    int kept = 0, count = size(list);
+    stageRing(list, count);
+    for(int i = 0; i < count; i++){
+        TYPE value = *slotAt(list, i);
+        if(!match(value, arg)) *stagedAt(list, kept++) = value;
+    }
+    STAT_ADD(list, traversed, count);
+    publishRing(list, list->stage, kept);
+    changed(list);
+    return count - kept;
+}
+
+// Splice interface, array rings copy the values
+
+/*********************************************************************
+** Function: circularListConcat
+** Description: moves every value of other onto the back of list,
+**              leaving other empty; the values are copied
+**
+** Parameters:  two CircularLists
+**
+** Pre-Conditions: the lists are different
+** Post-Conditions: other is empty
+**
+**
+*******************************************************************/
+void circularListConcat(struct CircularList* list, struct CircularList* other)
+{
+    assert(list!=0 && other!=0 && list!=other);
+    moveValues(other, size(other), 0, size(other), list, size(list), size(list));
+}
+
+/*********************************************************************
+** Function: circularListSplice
+** Description: moves the values from first through last, both
+**              included, in front of position in another list
+**
+** Parameters:  a cursor on the value to insert before, or past the
+**              back to append, and cursors on the first and last
+**              value to move
+**
+** Pre-Conditions: first and last are valid cursors of one list, last
+**                 is not before first, position is on another list
+** Post-Conditions: position is still on the same value; first and
+**                  last are not valid any more
+**
+*******************************************************************/
+void circularListSplice(struct CircularListCursor* position, struct CircularListCursor* first,
+                        struct CircularListCursor* last)
+{
+    assert(position!=0 && position->index>=0 && position->index<=size(position->list));
+    assert(circularListCursorValid(first) && circularListCursorValid(last));
+    assert(first->list==last->list && first->list!=position->list);
+    assert(first->index<=last->index);
+
+    int count = last->index - first->index + 1;
+    moveValues(first->list, size(first->list), first->index, count,
+               position->list, size(position->list), position->index);
+    position->index += count;
+}
+
+/*********************************************************************
+** Function: circularListSplit
+** Description: moves the value under the cursor and every value after
+**              it onto the back of other
+**
+** Parameters:  a cursor and the list to move the values to
+**
+** Pre-Conditions: the cursor is valid, other is another list
+** Post-Conditions: the cursor's list ends just before where the
+**                  cursor was, the cursor is past its back
+**
+*******************************************************************/
+void circularListSplit(struct CircularListCursor* cursor, struct CircularList* other)
+{
+    assert(circularListCursorValid(cursor));
+    struct CircularList * list = cursor->list;
+    assert(other!=0 && other!=list);
+
+    moveValues(list, size(list), cursor->index, size(list) - cursor->index, other, size(other), size(other));
+    cursor->index = size(list);
+}
+
+// Ordered interface
+
+/*********************************************************************
+** Function: valueAt
+** Description: returns the address of the value the given distance
+**              from the front, for the ordering in circularListSort.h
+**
+** Parameters:  a CircularList and index
+**
+** Pre-Conditions: 0 <= index < size
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+static TYPE* valueAt(struct CircularList* list, int index)
+{
+    return slotAt(list, list->header->reversed ? size(list) - 1 - index : index);
+}
+
+/*********************************************************************
+** Function: stagedValueAt
+** Description: returns the address of the value the given distance
+**              from the front in a same-sized rewrite started by
+**              stageRing
+**
+** Parameters:  a CircularList and index
+**
+** Pre-Conditions: stageRing reserved size slots, 0 <= index < size
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+static TYPE* stagedValueAt(struct CircularList* list, int index)
+{
+    return stagedAt(list, list->header->reversed ? size(list) - 1 - index : index);
+}
+
+/*********************************************************************
+** Function: circularListSort
+** Description: sorts the list by LT with the stable merge sort from
+**              circularListSort.h, in O(n log^2 n). The values are
+**              copied into the free slots after the tail and sorted
+**              there, so nothing is allocated beyond growing the ring
+**              when it is under half free, and a crash leaves the
+**              list unsorted or sorted but never half done
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the list is in order, equal values in the order
+**                  they were in before
+**
+*******************************************************************/
+void circularListSort(struct CircularList* list)
+{
+    assert(list!=0);
+    int count = size(list);
+    stageRing(list, count);
+    for(int i = 0; i < count; i++) *stagedAt(list, i) = *slotAt(list, i);
+    sortSlots(list, stagedValueAt, count);
+    publishRing(list, list->stage, count);
+    STAT_ADD(list, traversed, count);
+    changed(list);
+}
+
+/*********************************************************************
+** Function: circularListAddSorted
+** Description: adds a value after every value not greater than it,
+**              found with a binary search. At either end it is one
+**              deque call; anywhere else the list is written into the
+**              free slots with the value in place and switched to,
+**              which allocates nothing beyond growing the ring when
+**              it is under half free
+**
+** Parameters:  a CircularList and value
+**
+** Pre-Conditions: the list is sorted by LT
+** Post-Conditions: the list is still sorted, the value after any
+**                  equal values
+**
+*******************************************************************/
+void circularListAddSorted(struct CircularList* list, TYPE value)
+{
+    assert(list!=0);
+    int count = size(list);
+    int i = 0, j = count;
+    while(i < j){
+        int h = (i + j) / 2;
+        if(LT(value, *valueAt(list, h))) j = h;
+        else i = h + 1;
+    }
+
+    if(i == 0) circularListAddFront(list, value);
+    else if(i == count) circularListAddBack(list, value);
+    else {
+        // staged in stored order, the front is at the far end when reversed
+        stageRing(list, count + 1);
+        for(int k = 0; k <= count; k++){
+            TYPE* slot = stagedAt(list, list->header->reversed ? count - k : k);
+            if(k < i) *slot = *valueAt(list, k);
+            else if(k == i) *slot = value;
+            else *slot = *valueAt(list, k - 1);
+        }
+        publishRing(list, list->stage, count + 1);
+        changed(list);
+    }
+}
+
+/*********************************************************************
+** Function: circularListMerge
+** Description: merges every value of other into list in O(n+m) with
+**              the deque calls alone, leaving other empty; nothing is
+**              allocated beyond growing list's ring. Each call commits
+**              on its own, so a crash part way can leave a value in
+**              both lists or twice in list
+**
+** Parameters:  two CircularLists
+**
+** Pre-Conditions: the lists are different and both sorted by LT
+** Post-Conditions: list is sorted, values equal to one of list's come
+**                  after it, other is empty
+**
+*******************************************************************/
+void circularListMerge(struct CircularList* list, struct CircularList* other)
+{
+    assert(list!=0 && other!=0 && list!=other);
+    mergeSorted(list, size(list), other);
+}
+
+// Instrumentation interface, allocations and frees count mappings
+
+/*********************************************************************
+** Function: circularListStats
+** Description: copies the list's instrumentation counters; every
+**              counter reads 0 unless the list was built with
+**              CS261_STATS defined, allocations and frees count
+**              mappings
+**
+** Parameters:  a CircularList and where to copy the counters
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: stats holds the counters since the last reset
+**
+**
+*******************************************************************/
+void circularListStats(struct CircularList* list, struct CircularListStats* stats)
+{
+    assert(list!=0 && stats!=0);
+#ifdef CS261_STATS
+    *stats = list->stats;
+#else
+    stats->allocations = 0;
+    stats->frees = 0;
+    stats->traversed = 0;
+    stats->peakSize = 0;
+#endif
+}
+
+/*********************************************************************
+** Function: circularListStatsReset
+** Description: zeroes the list's instrumentation counters, the peak
+**              size starts over from the current size
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the counters read 0
+**
+**
+*******************************************************************/
+void circularListStatsReset(struct CircularList* list)
+{
+    assert(list!=0);
+#ifdef CS261_STATS
+    list->stats.allocations = 0;
+    list->stats.frees = 0;
+    list->stats.traversed = 0;
+    list->stats.peakSize = size(list);
+#endif
+}
+
+/*********************************************************************
+** Function: circularListStatsPrint
+** Description: prints the list's instrumentation counters as one line
+**              of JSON
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the counters have been printed
+**
+**
+*******************************************************************/
+void circularListStatsPrint(struct CircularList* list)
+{
+    struct CircularListStats stats;
+    circularListStats(list, &stats);
+    printf("{\"structure\": \"CircularListFile\", \"allocations\": %lu, \"frees\": %lu, "
+           "\"traversed\": %lu, \"peak_size\": %d}\n",
+           stats.allocations, stats.frees, stats.traversed, stats.peakSize);
+}
@@ -0,0 +1,20 @@
+#ifndef CIRCULAR_FILE_LIST_H
+#define CIRCULAR_FILE_LIST_H
+
+#include "circularList.h"
+
+// Extra interface of the file backed CircularList in circularFileList.c.
+// An operation on one list takes effect with a single header store, so
+// after a crash of the process the list holds every operation that
+// completed and nothing of one cut off part way. Concat, Splice, Split
+// and Merge work through the deque calls of both lists, and a crash
+// between those calls leaves the move half done. Only what the last
+// sync covered is sure to survive a crash of the machine.
+
+#define CIRCULAR_FILE_LIST_VERSION 2
+
+struct CircularList* circularListOpen(const char* path);
+int circularListSync(struct CircularList* list);
+void circularListSyncEvery(struct CircularList* list, int operations);
+
+#endif
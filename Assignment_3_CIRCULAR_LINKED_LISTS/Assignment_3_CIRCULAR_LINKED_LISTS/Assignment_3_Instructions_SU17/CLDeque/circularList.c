@@ -21,6 +21,28 @@
 #include <assert.h>
 #include "circularList.h"
 
+// Number of links carved out of each page of a pooled list
+#ifndef LINK_PAGE_SIZE
+#define LINK_PAGE_SIZE 256
+#endif
+
+// Cache hint for link walks, a no-op on compilers without it
+#ifdef __GNUC__
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) ((void)0)
+#endif
+
+// Instrumentation counters, compiled out unless CS261_STATS is defined
+#ifdef CS261_STATS
+#define STAT_ADD(list, counter, n) ((list)->stats.counter += (n))
+#define STAT_PEAK(list) \
+    do { if((list)->size > (list)->stats.peakSize) (list)->stats.peakSize = (list)->size; } while(0)
+#else
+#define STAT_ADD(list, counter, n) ((void)0)
+#define STAT_PEAK(list) ((void)0)
+#endif
+
 // Double link
 struct Link
 {
@@ -29,10 +51,32 @@ struct Link
 	struct Link * prev;
 };
 
+// Contiguous page of links owned by a pooled list
+struct LinkPage
+{
+	struct LinkPage* next;
+	int count;
+	struct Link links[];
+};
+
 struct CircularList
 {
 	int size;
 	struct Link* sentinel;
+	
+	// when set the list reads from sentinel->prev toward sentinel->next,
+	// so front and back trade places
+	int reversed;
+	
+	// slab allocator state, only used when pooled is set
+	int pooled;
+	struct LinkPage* pages;
+	struct Link* freeLinks;
+	int freeCount;
+
+#ifdef CS261_STATS
+	struct CircularListStats stats;
+#endif
 };
 
 
@@ -60,6 +104,92 @@ static void init(struct CircularList* list)
     list->sentinel->next = list->sentinel;
     list->sentinel->prev = list->sentinel;
     list->size = 0;
+    list->reversed = 0;
+    
+    // lists start out using malloc for every link
+    list->pooled = 0;
+    list->pages = 0;
+    list->freeLinks = 0;
+    list->freeCount = 0;
+    
+    circularListStatsReset(list);
+}
+
+/*********************************************************************
+** Function: addLinkPage
+**
+** Description: allocates a page of count links and pushes every link
+**              in it onto the list's free links
+**
+** Parameters:  a CircularList and the number of links in the page
+**
+** Pre-Conditions:  list has been initialized and is pooled
+** Post-Conditions: a new page is at the head of the list's pages and
+**                  its links are available to createLink
+********************************************************************/
+static void addLinkPage(struct CircularList* list, int count)
+{
+    assert(list!=0 && count>0);
+    
+    // one malloc for the page header and all of its links
+    struct LinkPage * page = malloc(sizeof(struct LinkPage) +
+                                    count * sizeof(struct Link));
+    assert(page!=0);
+    STAT_ADD(list, allocations, 1);
+    page->count = count;
+    page->next = list->pages;
+    list->pages = page;
+    
+    // thread the links onto the free list, first link on top
+    for(int i = count - 1; i >= 0; i--){
+        page->links[i].next = list->freeLinks;
+        list->freeLinks = &page->links[i];
+    }
+    list->freeCount += count;
+}
+
+/*********************************************************************
+** Function: freeLink
+**
+** Description: gives a link back to the list's free links, or to libc
+**              when the list is not pooled
+**
+** Parameters:  a CircularList and Link
+**
+** Pre-Conditions:  link came from createLink on the same list and is
+**                  no longer linked in
+** Post-Conditions: the link may be handed out again by createLink
+********************************************************************/
+static void freeLink(struct CircularList* list, struct Link* link)
+{
+    if(!list->pooled){
+        free(link);
+        STAT_ADD(list, frees, 1);
+        return;
+    }
+    link->next = list->freeLinks;
+    list->freeLinks = link;
+    list->freeCount++;
+}
+
+/*********************************************************************
+** Function: reserveLinks
+**
+** Description: makes sure a pooled list can hand out count links
+**              without allocating, using a single page for the shortfall
+**
+** Parameters:  a CircularList and the number of links needed
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: the next count calls to createLink on a pooled list
+**                  will not allocate
+********************************************************************/
+static void reserveLinks(struct CircularList* list, int count)
+{
+    if(!list->pooled || list->freeCount >= count) return;
+    
+    int shortfall = count - list->freeCount;
+    addLinkPage(list, shortfall > LINK_PAGE_SIZE ? shortfall : LINK_PAGE_SIZE);
 }
 
 /**
@@ -69,21 +199,34 @@ static void init(struct CircularList* list)
 /*********************************************************************
 ** Function: createLink
 **
-** Description: creates a link with the given value and NULL next and
-**              prev pointers
+** Description: creates a link with the given value, taken from the
+**              list's free links when the list is pooled
 **
-** Parameters:  a value
+** Parameters:  a CircularList and value
 **
-** Pre-Conditions:  NONE
+** Pre-Conditions:  list has been initialized
 ** Post-Conditions: space allocated for new Link with the passed value
 ********************************************************************/
-static struct Link* createLink(TYPE value)
+static struct Link* createLink(struct CircularList* list, TYPE value)
 {
-    // allocate memory for newLink
-    struct Link * newLink = (struct Link*)malloc(sizeof(struct Link));
-    
-    // assert memory allocated properly
-    assert(newLink!=0);
+    struct Link * newLink;
+    if(list->pooled){
+        // refill from a fresh page only when every recycled link is in use
+        if(list->freeLinks == 0){
+            addLinkPage(list, LINK_PAGE_SIZE);
+        }
+        newLink = list->freeLinks;
+        list->freeLinks = newLink->next;
+        list->freeCount--;
+    }
+    else {
+        // allocate memory for newLink
+        newLink = (struct Link*)malloc(sizeof(struct Link));
+        
+        // assert memory allocated properly
+        assert(newLink!=0);
+        STAT_ADD(list, allocations, 1);
+    }
     
     newLink->value = value;
     
@@ -110,7 +253,7 @@ static void addLinkAfter(struct CircularList* list, struct Link* link, TYPE valu
     assert(list!=0 && link!=0);
     
     // create link
-    struct Link * newLink = createLink(value);
+    struct Link * newLink = createLink(list, value);
     
     // store link next value in temp
     struct Link * temp = link->next;
@@ -127,6 +270,50 @@ static void addLinkAfter(struct CircularList* list, struct Link* link, TYPE valu
     newLink->prev = link;
     
     list->size++;
+    STAT_PEAK(list);
+}
+
+
+/*********************************************************************
+** Function: addLinksAfter
+**
+** Description: adds count new links holding values after the given
+**              link and grows the list's size once, the links follow
+**              array order unless backward is set
+**
+**
+** Parameters:  a CircularList, Link, array of values, number of values
+**              and whether to take the values last to first
+**
+** Pre-Conditions: list and link are both initialized, values holds at
+**                 least count values
+** Post-Conditions: the new links sit between the passed link and its
+**                  old next link
+********************************************************************/
+static void addLinksAfter(struct CircularList* list, struct Link* link,
+                          const TYPE* values, int count, int backward)
+{
+    // check pre-conditions
+    assert(list!=0 && link!=0);
+    assert(count>=0 && (values!=0 || count==0));
+    
+    reserveLinks(list, count);
+    
+    // chain the new links off the passed link
+    struct Link * next = link->next;
+    struct Link * last = link;
+    for(int i = 0; i < count; i++){
+        struct Link * newLink = createLink(list, values[backward ? count - 1 - i : i]);
+        newLink->prev = last;
+        last->next = newLink;
+        last = newLink;
+    }
+    
+    // close the chain onto the old next link
+    last->next = next;
+    next->prev = last;
+    list->size += count;
+    STAT_PEAK(list);
 }
 
 
@@ -152,17 +339,115 @@ static void removeLink(struct CircularList* list, struct Link* link)
     struct Link * tempN = link->next;
     struct Link * tempP = link->prev;
     
-    // free the link
-    free(link);
-    
     // set temps to point to each other
     tempN->prev = tempP;
     tempP->next = tempN;
     
+    // free the link
+    freeLink(list, link);
+    
     list->size--;
     
 }
 
+/*********************************************************************
+** Function: frontLink
+**
+** Description: returns the link at the front of the list, which is
+**              the sentinel's prev when the list is reversed
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: list is initialized
+** Post-Conditions: NONE
+********************************************************************/
+static struct Link* frontLink(struct CircularList* list)
+{
+    return list->reversed ? list->sentinel->prev : list->sentinel->next;
+}
+
+/*********************************************************************
+** Function: backLink
+**
+** Description: returns the link at the back of the list, which is
+**              the sentinel's next when the list is reversed
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: list is initialized
+** Post-Conditions: NONE
+********************************************************************/
+static struct Link* backLink(struct CircularList* list)
+{
+    return list->reversed ? list->sentinel->next : list->sentinel->prev;
+}
+
+/*********************************************************************
+** Function: removeLinksAfter
+**
+** Description: removes up to count links following the sentinel's
+**              next pointers, copying their values into out in the
+**              order they are removed
+**
+** Parameters:  a CircularList, output array and maximum number to
+**              remove
+**
+** Pre-Conditions: list is initialized, out has room for count values
+** Post-Conditions: returns how many links were removed
+********************************************************************/
+static int removeLinksAfter(struct CircularList* list, TYPE* out, int count)
+{
+    assert(list!=0 && count>=0);
+    if(count > list->size) count = list->size;
+    
+    struct Link * temp = list->sentinel->next;
+    for(int i = 0; i < count; i++){
+        struct Link * next = temp->next;
+        out[i] = temp->value;
+        freeLink(list, temp);
+        temp = next;
+    }
+    
+    // relink the sentinel to the first link that is left
+    list->sentinel->next = temp;
+    temp->prev = list->sentinel;
+    list->size -= count;
+    return count;
+}
+
+/*********************************************************************
+** Function: removeLinksBefore
+**
+** Description: removes up to count links following the sentinel's
+**              prev pointers, copying their values into out in the
+**              order they are removed
+**
+** Parameters:  a CircularList, output array and maximum number to
+**              remove
+**
+** Pre-Conditions: list is initialized, out has room for count values
+** Post-Conditions: returns how many links were removed
+********************************************************************/
+static int removeLinksBefore(struct CircularList* list, TYPE* out, int count)
+{
+    assert(list!=0 && count>=0);
+    if(count > list->size) count = list->size;
+    
+    struct Link * temp = list->sentinel->prev;
+    for(int i = 0; i < count; i++){
+        struct Link * prev = temp->prev;
+        out[i] = temp->value;
+        freeLink(list, temp);
+        temp = prev;
+    }
+    
+    // relink the sentinel to the last link that is left
+    list->sentinel->prev = temp;
+    temp->next = list->sentinel;
+    list->size -= count;
+    return count;
+}
+
 /*********************************************************************
 ** Function: circularListCreate
 **
@@ -182,10 +467,31 @@ struct CircularList* circularListCreate()
 	return list;
 }
 
+/*********************************************************************
+** Function: circularListCreatePooled
+**
+** Description: allocates and initializes a list whose links are carved
+**              out of contiguous pages and recycled on removal instead
+**              of going back to malloc and free
+**
+** Parameters:  none
+**
+** Pre-Conditions: none
+** Post-Conditions: returns an empty pooled list, its pages are only
+**                  released by circularListDestroy
+********************************************************************/
+struct CircularList* circularListCreatePooled()
+{
+	struct CircularList* list = circularListCreate();
+	list->pooled = 1;
+	return list;
+}
+
 /*********************************************************************
 ** Function: circularListDestroy
 **
-** Description: destroys a CircularList
+** Description: destroys a CircularList, a pooled list releases its
+**              pages all at once
 **
 ** Parameters:  a CircularListn
 **
@@ -196,7 +502,17 @@ struct CircularList* circularListCreate()
 void circularListDestroy(struct CircularList* list)
 {
 	// check that list is not null
-    assert(list!=0 && list->size>0);
+    assert(list!=0);
+    
+    if(list->pooled){
+        // every link lives in a page, so no need to unlink them one by one
+        while(list->pages!=0){
+            struct LinkPage * page = list->pages;
+            list->pages = page->next;
+            free(page);
+        }
+        list->size = 0;
+    }
     
     // remove all links
     while(list->size!=0){
@@ -225,7 +541,12 @@ void circularListAddFront(struct CircularList* list, TYPE value)
 {
     assert(list!=0);
     
-    addLinkAfter(list, list->sentinel, value);
+    if(list->reversed){
+        addLinkAfter(list, list->sentinel->prev, value);
+    }
+    else {
+        addLinkAfter(list, list->sentinel, value);
+    }
 }
 
 /*********************************************************************
@@ -245,7 +566,12 @@ void circularListAddBack(struct CircularList* list, TYPE value)
 {
     assert(list!=0);
     
-    addLinkAfter(list, list->sentinel->prev, value);
+    if(list->reversed){
+        addLinkAfter(list, list->sentinel, value);
+    }
+    else {
+        addLinkAfter(list, list->sentinel->prev, value);
+    }
 }
 
 
@@ -264,7 +590,7 @@ TYPE circularListFront(struct CircularList* list)
 {
     assert(list!=0);
     
-    return list->sentinel->next->value;
+    return frontLink(list)->value;
 }
 
 /*********************************************************************
@@ -282,7 +608,43 @@ TYPE circularListBack(struct CircularList* list)
 {
     assert(list!=0);
     
-    return list->sentinel->prev->value;
+    return backLink(list)->value;
+}
+
+/*********************************************************************
+ ** Function: circularListGet
+ ** Description: returns the value at the given index from the front,
+ **              walking in from whichever end is closer
+ **
+ ** Parameters:  a CircularList and index
+ **
+ ** Pre-Conditions: 0 <= index < size
+ ** Post-Conditions: the value at index has been returned
+ **
+ **
+ ********************************************************************/
+TYPE circularListGet(struct CircularList* list, int index)
+{
+    assert(list!=0);
+    assert(index>=0 && index<list->size);
+    
+    // count from the sentinel's next link
+    if(list->reversed){
+        index = list->size - 1 - index;
+    }
+    
+    struct Link * temp;
+    if(index < list->size / 2){
+        STAT_ADD(list, traversed, index + 1);
+        temp = list->sentinel->next;
+        while(index-- > 0) temp = temp->next;
+    }
+    else {
+        STAT_ADD(list, traversed, list->size - index);
+        temp = list->sentinel->prev;
+        for(index = list->size - 1 - index; index > 0; index--) temp = temp->prev;
+    }
+    return temp->value;
 }
 
 /*********************************************************************
@@ -301,7 +663,7 @@ void circularListRemoveFront(struct CircularList* list)
     assert(list!=0);
     assert(list->sentinel->next!=list->sentinel);
     
-    removeLink(list, list->sentinel->next);
+    removeLink(list, frontLink(list));
     
 }
 
@@ -321,90 +683,959 @@ void circularListRemoveBack(struct CircularList* list)
     assert(list!=0);
     assert(list->sentinel->prev!=list->sentinel);
     
-    removeLink(list, list->sentinel->prev);
+    removeLink(list, backLink(list));
 }
 
 /*********************************************************************
-** Function: circularListisEmpty
-** Description: returns 1 if list is empty and 0 if not
+** Function: circularListAddFrontArray
+** Description: adds count values to the front of the deque, keeping
+**              their array order, so values[0] becomes the front
 **
-** Parameters:  a CircularList
+** Parameters:  a CircularList, array of values and number of values
+**
+** Pre-Conditions: the list has been initialized, values holds count
+**                 values
+** Post-Conditions: the values are at the front of the list
+**
+*******************************************************************/
+void circularListAddFrontArray(struct CircularList* list, const TYPE* values, int count)
+{
+    assert(list!=0);
+    
+    // a reversed list's front is the sentinel's prev, so the values go
+    // there last to first
+    if(list->reversed){
+        addLinksAfter(list, list->sentinel->prev, values, count, 1);
+    }
+    else {
+        addLinksAfter(list, list->sentinel, values, count, 0);
+    }
+}
+
+/*********************************************************************
+** Function: circularListAddBackArray
+** Description: adds count values to the back of the deque in array
+**              order, so values[count-1] becomes the back
+**
+** Parameters:  a CircularList, array of values and number of values
+**
+** Pre-Conditions: the list has been initialized, values holds count
+**                 values
+** Post-Conditions: the values are at the back of the list
+**
+*******************************************************************/
+void circularListAddBackArray(struct CircularList* list, const TYPE* values, int count)
+{
+    assert(list!=0);
+    
+    // a reversed list's back is the sentinel's next, so the values go
+    // there last to first
+    if(list->reversed){
+        addLinksAfter(list, list->sentinel, values, count, 1);
+    }
+    else {
+        addLinksAfter(list, list->sentinel->prev, values, count, 0);
+    }
+}
+
+/*********************************************************************
+** Function: circularListRemoveFrontArray
+** Description: removes up to count links from the front, copying their
+**              values front to back into out
+**
+** Parameters:  a CircularList, output array and maximum number to
+**              remove
+**
+** Pre-Conditions: the list has been initialized, out has room for
+**                 count values
+** Post-Conditions: returns how many values were removed
+**
+*******************************************************************/
+int circularListRemoveFrontArray(struct CircularList* list, TYPE* out, int count)
+{
+    assert(list!=0);
+    
+    if(list->reversed){
+        return removeLinksBefore(list, out, count);
+    }
+    return removeLinksAfter(list, out, count);
+}
+
+/*********************************************************************
+** Function: circularListRemoveBackArray
+** Description: removes up to count links from the back, copying their
+**              values into out in the order they are removed, back
+**              first
+**
+** Parameters:  a CircularList, output array and maximum number to
+**              remove
+**
+** Pre-Conditions: the list has been initialized, out has room for
+**                 count values
+** Post-Conditions: returns how many values were removed
+**
+*******************************************************************/
+int circularListRemoveBackArray(struct CircularList* list, TYPE* out, int count)
+{
+    assert(list!=0);
+    
+    if(list->reversed){
+        return removeLinksAfter(list, out, count);
+    }
+    return removeLinksBefore(list, out, count);
+}
+
+/*********************************************************************
+** Function: circularListDrain
+** Description: removes every link, copying the values front to back
+**              into out
+**
+** Parameters:  a CircularList and output array
+**
+** Pre-Conditions: the list has been initialized, out has room for
+**                 every value in the list
+** Post-Conditions: the list is empty, returns how many values were
+**                  removed
+**
+*******************************************************************/
+int circularListDrain(struct CircularList* list, TYPE* out)
+{
+    assert(list!=0);
+    
+    return circularListRemoveFrontArray(list, out, list->size);
+}
+
+/*********************************************************************
+** Function: circularListContains
+** Description: returns 1 if some link holds value and 0 if not
+**
+** Parameters:  a CircularList and value to look for
 **
 ** Pre-Conditions: the list has been initialized
-** Post-Conditions: returns 1 if list is empty and 0 if not
+** Post-Conditions: NONE
 **
 **
 *******************************************************************/
-int circularListIsEmpty(struct CircularList* list)
+int circularListContains(struct CircularList* list, TYPE value)
+{
+    return circularListFindIndex(list, value) >= 0;
+}
+
+/*********************************************************************
+** Function: circularListFindIndex
+** Description: returns the index from the front of the first link
+**              holding value
+**
+** Parameters:  a CircularList and value to look for
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: returns the index, or -1 if no link holds value
+**
+**
+*******************************************************************/
+int circularListFindIndex(struct CircularList* list, TYPE value)
 {
     assert(list!=0);
-    if(list->size == 0){
-        return 1;
+    
+    int index = 0;
+    for(struct Link * temp = frontLink(list); temp!=list->sentinel; index++){
+        if(EQ(temp->value, value)){
+            STAT_ADD(list, traversed, index + 1);
+            return index;
+        }
+        temp = list->reversed ? temp->prev : temp->next;
     }
-	return 0;
+    STAT_ADD(list, traversed, list->size);
+    return -1;
 }
 
 /*********************************************************************
-** Function: circularListPrint
-** Description: prints each link in the list
+** Function: circularListCount
+** Description: returns how many links hold value
 **
-** Parameters:  a CircularList
+** Parameters:  a CircularList and value to count
 **
 ** Pre-Conditions: the list has been initialized
-** Post-Conditions: the list of link values has been printed
+** Post-Conditions: NONE
 **
 **
 *******************************************************************/
-void circularListPrint(struct CircularList* list)
+int circularListCount(struct CircularList* list, TYPE value)
 {
     assert(list!=0);
     
-    struct Link * temp = list->sentinel->next;
-    while(temp!= list->sentinel){
-        printf("%f ", temp->value);
-        temp = temp->next;
+    int found = 0;
+    for(struct Link * temp = list->sentinel->next; temp!=list->sentinel; temp = temp->next){
+        if(EQ(temp->value, value)) found++;
     }
-    printf("\n");
+    STAT_ADD(list, traversed, list->size);
+    return found;
 }
 
 /*********************************************************************
-** Function: circularListReverse
-** Description: reverses the list
+** Function: circularListSum
+** Description: returns the sum of every value, front to back
 **
 ** Parameters:  a CircularList
 **
 ** Pre-Conditions: the list has been initialized
-** Post-Conditions: the list of links has been reversed
+** Post-Conditions: returns the sum, 0 for an empty list
 **
 **
 *******************************************************************/
-void circularListReverse(struct CircularList* list)
+TYPE circularListSum(struct CircularList* list)
 {
     assert(list!=0);
-    assert(list->sentinel->next!=list->sentinel);
-    
-    // Links for storing next and last elements to move
-    struct Link * next = list->sentinel->prev;
-    struct Link * last = list->sentinel;
     
-    // count for how many elements to move
-    int count = list->size;
+    TYPE sum = 0;
+    for(struct Link * temp = frontLink(list); temp!=list->sentinel;
+        temp = list->reversed ? temp->prev : temp->next){
+        sum += temp->value;
+    }
+    STAT_ADD(list, traversed, list->size);
+    return sum;
+}
+
+/*********************************************************************
+** Function: circularListMin
+** Description: returns the smallest value in the list
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized and is not empty
+** Post-Conditions: returns the smallest value
+**
+**
+*******************************************************************/
+TYPE circularListMin(struct CircularList* list)
+{
+    assert(list!=0 && list->size>0);
     
+    TYPE min = list->sentinel->next->value;
+    for(struct Link * temp = list->sentinel->next->next; temp!=list->sentinel; temp = temp->next){
+        if(LT(temp->value, min)) min = temp->value;
+    }
+    STAT_ADD(list, traversed, list->size);
+    return min;
+}
+
+/*********************************************************************
+** Function: circularListMax
+** Description: returns the largest value in the list
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized and is not empty
+** Post-Conditions: returns the largest value
+**
+**
+*******************************************************************/
+TYPE circularListMax(struct CircularList* list)
+{
+    assert(list!=0 && list->size>0);
     
-    while(count!=0){
-        // add link after the last element to be moved
-        // initially this is just the sentinel
-        addLinkAfter(list, last, next->value);
-        
-        // update last element to be moved
-        last = last->next;
-        // update the next element to be moved
-        next = next->prev;
-        
-        // remove the element that was copied
-        circularListRemoveBack(list);
-        
-        
-        count--;
+    TYPE max = list->sentinel->next->value;
+    for(struct Link * temp = list->sentinel->next->next; temp!=list->sentinel; temp = temp->next){
+        if(LT(max, temp->value)) max = temp->value;
     }
+    STAT_ADD(list, traversed, list->size);
+    return max;
+}
+
+/*********************************************************************
+** Function: circularListisEmpty
+** Description: returns 1 if list is empty and 0 if not
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: returns 1 if list is empty and 0 if not
+**
+**
+*******************************************************************/
+int circularListIsEmpty(struct CircularList* list)
+{
+    assert(list!=0);
+    if(list->size == 0){
+        return 1;
+    }
+	return 0;
+}
+
+/*********************************************************************
+** Function: circularListPrint
+** Description: prints each link in the list
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the list of link values has been printed
+**
+**
+*******************************************************************/
+void circularListPrint(struct CircularList* list)
+{
+    assert(list!=0);
+    
+    struct Link * temp = frontLink(list);
+    while(temp!= list->sentinel){
+        printf("%f ", temp->value);
+        temp = list->reversed ? temp->prev : temp->next;
+    }
+    printf("\n");
+}
+
+/*********************************************************************
+** Function: circularListReverse
+** Description: reverses the list in place by swapping the next and prev
+**              pointers of every link, nothing is allocated
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the list of links has been reversed
+**
+**
+*******************************************************************/
+void circularListReverse(struct CircularList* list)
+{
+    assert(list!=0);
+    
+    // the sentinel is swapped too, so its old prev becomes the front
+    struct Link * temp = list->sentinel;
+    do {
+        struct Link * next = temp->next;
+        temp->next = temp->prev;
+        temp->prev = next;
+        temp = next;
+    } while(temp!=list->sentinel);
+    STAT_ADD(list, traversed, list->size);
+}
+
+/*********************************************************************
+** Function: circularListReverseLazy
+** Description: reverses the list in O(1) by flipping which end of the
+**              sentinel is the front, every deque operation honors it
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: front and back have traded places
+**
+**
+*******************************************************************/
+void circularListReverseLazy(struct CircularList* list)
+{
+    assert(list!=0);
+    
+    list->reversed = !list->reversed;
+}
+
+/*********************************************************************
+** Function: circularListCursorBegin
+** Description: puts a cursor on the front value
+**
+** Parameters:  a CircularList and cursor
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the cursor is valid unless the list is empty
+**
+**
+*******************************************************************/
+void circularListCursorBegin(struct CircularList* list, struct CircularListCursor* cursor)
+{
+    assert(list!=0 && cursor!=0);
+    cursor->list = list;
+    cursor->link = frontLink(list);
+    cursor->index = 0;
+}
+
+/*********************************************************************
+** Function: circularListCursorLast
+** Description: puts a cursor on the back value, for walking the list
+**              back to front with circularListCursorPrev
+**
+** Parameters:  a CircularList and cursor
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the cursor is valid unless the list is empty
+**
+**
+*******************************************************************/
+void circularListCursorLast(struct CircularList* list, struct CircularListCursor* cursor)
+{
+    assert(list!=0 && cursor!=0);
+    cursor->list = list;
+    cursor->link = backLink(list);
+    cursor->index = list->size - 1;
+}
+
+/*********************************************************************
+** Function: circularListCursorValid
+** Description: returns 1 if the cursor is on a value and 0 once it
+**              has moved past either end
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor has been placed by Begin or Last
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+int circularListCursorValid(struct CircularListCursor* cursor)
+{
+    assert(cursor!=0);
+    return cursor->link!=cursor->list->sentinel;
+}
+
+/*********************************************************************
+** Function: circularListCursorNext
+** Description: moves the cursor one value toward the back, fetching
+**              the link after that into cache while the caller works
+**              on this one
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor is valid
+** Post-Conditions: the cursor is on the next value or past the back
+**
+**
+*******************************************************************/
+void circularListCursorNext(struct CircularListCursor* cursor)
+{
+    assert(circularListCursorValid(cursor));
+    if(cursor->list->reversed){
+        cursor->link = cursor->link->prev;
+        PREFETCH(cursor->link->prev);
+    }
+    else {
+        cursor->link = cursor->link->next;
+        PREFETCH(cursor->link->next);
+    }
+    cursor->index++;
+}
+
+/*********************************************************************
+** Function: circularListCursorPrev
+** Description: moves the cursor one value toward the front
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor is valid
+** Post-Conditions: the cursor is on the previous value or past the
+**                  front
+**
+**
+*******************************************************************/
+void circularListCursorPrev(struct CircularListCursor* cursor)
+{
+    assert(circularListCursorValid(cursor));
+    if(cursor->list->reversed){
+        cursor->link = cursor->link->next;
+        PREFETCH(cursor->link->next);
+    }
+    else {
+        cursor->link = cursor->link->prev;
+        PREFETCH(cursor->link->prev);
+    }
+    cursor->index--;
+}
+
+/*********************************************************************
+** Function: circularListCursorGet
+** Description: returns the value under the cursor
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor is valid
+** Post-Conditions: NONE
+**
+**
+*******************************************************************/
+TYPE circularListCursorGet(struct CircularListCursor* cursor)
+{
+    assert(circularListCursorValid(cursor));
+    return cursor->link->value;
+}
+
+/*********************************************************************
+** Function: circularListCursorRemove
+** Description: removes the value under the cursor in O(1) and moves
+**              the cursor on to the value that followed it
+**
+** Parameters:  a cursor
+**
+** Pre-Conditions: the cursor is valid
+** Post-Conditions: the value is gone, the cursor is on the next value
+**                  or past the back
+**
+**
+*******************************************************************/
+void circularListCursorRemove(struct CircularListCursor* cursor)
+{
+    assert(circularListCursorValid(cursor));
+    struct Link * next = cursor->list->reversed ? cursor->link->prev : cursor->link->next;
+    removeLink(cursor->list, cursor->link);
+    cursor->link = next;
+}
+
+/*********************************************************************
+** Function: circularListForEach
+** Description: calls visit on every value front to back until visit
+**              returns 0, prefetching two links ahead of the visit
+**
+** Parameters:  a CircularList, the visitor and an argument passed to
+**              it
+**
+** Pre-Conditions: the list has been initialized, visit does not
+**                 change the list
+** Post-Conditions: returns how many values were visited
+**
+**
+*******************************************************************/
+int circularListForEach(struct CircularList* list, int (*visit)(TYPE value, void* arg), void* arg)
+{
+    assert(list!=0 && visit!=0);
+    
+    int visited = 0;
+    struct Link * temp = frontLink(list);
+    while(temp!=list->sentinel){
+        struct Link * next = list->reversed ? temp->prev : temp->next;
+        PREFETCH(list->reversed ? next->prev : next->next);
+        visited++;
+        if(!visit(temp->value, arg)) break;
+        temp = next;
+    }
+    STAT_ADD(list, traversed, visited);
+    return visited;
+}
+
+/*********************************************************************
+** Function: circularListRemoveIf
+** Description: removes every value match returns nonzero for, in one
+**              pass over the list
+**
+** Parameters:  a CircularList, the predicate and an argument passed
+**              to it
+**
+** Pre-Conditions: the list has been initialized, match does not
+**                 change the list
+** Post-Conditions: returns how many values were removed
+**
+**
+*******************************************************************/
+int circularListRemoveIf(struct CircularList* list, int (*match)(TYPE value, void* arg), void* arg)
+{
+    assert(list!=0 && match!=0);
+    
+    // order does not matter here, so the walk ignores reversed
+    int removed = 0;
+    struct Link * temp = list->sentinel->next;
+    while(temp!=list->sentinel){
+        struct Link * next = temp->next;
+        PREFETCH(next->next);
+        if(match(temp->value, arg)){
+            removeLink(list, temp);
+            removed++;
+        }
+        temp = next;
+    }
+    STAT_ADD(list, traversed, list->size + removed);
+    return removed;
+}
+
+/*********************************************************************
+** Function: moveLinks
+** Description: moves the run of count values from first to last, in
+**              front to back order, out of one list and in front of a
+**              link of another. Lists that malloc their links relink
+**              the run in O(1), flipping it link by link when only one
+**              of the lists is reversed. A pooled list keeps its links
+**              in its own pages, so to or from one the values are
+**              copied and the links freed instead
+**
+** Parameters:  the list the run is in, its first and last link and
+**              length, the list to move it to and the link to put it
+**              before, which may be that list's sentinel
+**
+** Pre-Conditions: the lists are different, first through last is a
+**                 run of from's links
+** Post-Conditions: the run sits in front of before, in order
+**
+*******************************************************************/
+static void moveLinks(struct CircularList* from, struct Link* first, struct Link* last, int count,
+                      struct CircularList* to, struct Link* before)
+{
+    assert(from!=to);
+    if(count == 0) return;
+    
+    if(from->pooled || to->pooled){
+        TYPE values[LINK_PAGE_SIZE];
+        for(int moved = 0; moved < count; ){
+            int n = 0;
+            while(moved < count && n < LINK_PAGE_SIZE){
+                struct Link * next = from->reversed ? first->prev : first->next;
+                values[n++] = first->value;
+                removeLink(from, first);
+                first = next;
+                moved++;
+            }
+            // the values go in behind the link before them in reading order
+            if(to->reversed) addLinksAfter(to, before, values, n, 1);
+            else addLinksAfter(to, before->prev, values, n, 0);
+        }
+        return;
+    }
+    
+    // the run in next pointer order
+    struct Link * head = from->reversed ? last : first;
+    struct Link * tail = from->reversed ? first : last;
+    head->prev->next = tail->next;
+    tail->next->prev = head->prev;
+    from->size -= count;
+    
+    if(from->reversed != to->reversed){
+        for(struct Link * temp = head; ; ){
+            struct Link * next = temp->next;
+            temp->next = temp->prev;
+            temp->prev = next;
+            if(temp == tail) break;
+            temp = next;
+        }
+        struct Link * swap = head;
+        head = tail;
+        tail = swap;
+    }
+    
+    struct Link * after = to->reversed ? before : before->prev;
+    struct Link * next = after->next;
+    after->next = head;
+    head->prev = after;
+    tail->next = next;
+    next->prev = tail;
+    to->size += count;
+    STAT_PEAK(to);
+}
+
+/*********************************************************************
+** Function: circularListConcat
+** Description: moves every value of other onto the back of list,
+**              leaving other empty
+**
+** Parameters:  two CircularLists
+**
+** Pre-Conditions: the lists are different
+** Post-Conditions: other is empty
+**
+**
+*******************************************************************/
+void circularListConcat(struct CircularList* list, struct CircularList* other)
+{
+    assert(list!=0 && other!=0 && list!=other);
+    moveLinks(other, frontLink(other), backLink(other), other->size, list, list->sentinel);
+}
+
+/*********************************************************************
+** Function: circularListSplice
+** Description: moves the values from first through last, both
+**              included, in front of position in another list
+**
+** Parameters:  a cursor on the value to insert before, or past the
+**              back to append, and cursors on the first and last
+**              value to move
+**
+** Pre-Conditions: first and last are valid cursors of one list, last
+**                 is not before first, position is on another list
+** Post-Conditions: position is still on the same value; first and
+**                  last are not valid any more
+**
+*******************************************************************/
+void circularListSplice(struct CircularListCursor* position, struct CircularListCursor* first,
+                        struct CircularListCursor* last)
+{
+    assert(position!=0 && position->index>=0 && position->index<=position->list->size);
+    assert(circularListCursorValid(first) && circularListCursorValid(last));
+    assert(first->list==last->list && first->list!=position->list);
+    assert(first->index<=last->index);
+    
+    int count = last->index - first->index + 1;
+    moveLinks(first->list, first->link, last->link, count, position->list, position->link);
+    position->index += count;
+}
+
+/*********************************************************************
+** Function: circularListSplit
+** Description: moves the value under the cursor and every value after
+**              it onto the back of other
+**
+** Parameters:  a cursor and the list to move the values to
+**
+** Pre-Conditions: the cursor is valid, other is another list
+** Post-Conditions: the cursor's list ends just before where the
+**                  cursor was, the cursor is past its back
+**
+*******************************************************************/
+void circularListSplit(struct CircularListCursor* cursor, struct CircularList* other)
+{
+    assert(circularListCursorValid(cursor));
+    struct CircularList * list = cursor->list;
+    assert(other!=0 && other!=list);
+    
+    moveLinks(list, cursor->link, backLink(list), list->size - cursor->index, other, other->sentinel);
+    cursor->link = list->sentinel;
+    cursor->index = list->size;
+}
+
+/*********************************************************************
+** Function: mergeChains
+** Description: merges two sorted chains linked through next and ended
+**              by null, taking from the first on ties so the merge is
+**              stable
+**
+** Parameters:  the earlier and the later chain
+**
+** Pre-Conditions: both chains are sorted by LT
+** Post-Conditions: returns the head of the merged chain, prev pointers
+**                  are left for the caller to fix
+**
+*******************************************************************/
+static struct Link* mergeChains(struct Link* first, struct Link* second)
+{
+    struct Link head;
+    struct Link * tail = &head;
+    while(first!=0 && second!=0){
+        if(LT(second->value, first->value)){
+            tail->next = second;
+            second = second->next;
+        }
+        else {
+            tail->next = first;
+            first = first->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = first!=0 ? first : second;
+    return head.next;
+}
+
+/*********************************************************************
+** Function: linkBefore
+** Description: links a link in front of another in reading order,
+**              which is after it in next order when the list is
+**              reversed
+**
+** Parameters:  a CircularList, the link to add and the link to put it
+**              before, which may be the sentinel
+**
+** Pre-Conditions: link is not in any list
+** Post-Conditions: size is left to the caller
+**
+**
+*******************************************************************/
+static void linkBefore(struct CircularList* list, struct Link* link, struct Link* before)
+{
+    struct Link * after = list->reversed ? before : before->prev;
+    link->prev = after;
+    link->next = after->next;
+    after->next->prev = link;
+    after->next = link;
+}
+
+/*********************************************************************
+** Function: circularListSort
+** Description: sorts the list by LT with a stable bottom-up merge sort
+**              that only relinks, in O(n log n) with no allocation.
+**              bins[i] holds a sorted run of 2^i links, and every link
+**              carries into the bins like a binary counter. A lazily
+**              reversed list comes out sorted and no longer reversed
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the list is in order, equal values in the order
+**                  they were in before
+**
+*******************************************************************/
+void circularListSort(struct CircularList* list)
+{
+    assert(list!=0);
+    if(list->size < 2) return;
+
+    struct Link * bins[64] = {0};
+    int used = 0;
+    struct Link * temp = frontLink(list);
+    while(temp != list->sentinel){
+        struct Link * carry = temp;
+        temp = list->reversed ? temp->prev : temp->next;
+        carry->next = 0;
+
+        // the bins hold earlier links, so they go first
+        int i = 0;
+        for(; bins[i]!=0; i++){
+            carry = mergeChains(bins[i], carry);
+            bins[i] = 0;
+        }
+        bins[i] = carry;
+        if(i >= used) used = i + 1;
+    }
+
+    // higher bins hold earlier links too
+    struct Link * sorted = 0;
+    for(int i = 0; i < used; i++){
+        if(bins[i]!=0) sorted = mergeChains(bins[i], sorted);
+    }
+    STAT_ADD(list, traversed, list->size);
+
+    // put the prev pointers back, reading front to back through next
+    struct Link * last = list->sentinel;
+    for(temp = sorted; temp!=0; temp = temp->next){
+        last->next = temp;
+        temp->prev = last;
+        last = temp;
+    }
+    last->next = list->sentinel;
+    list->sentinel->prev = last;
+    list->reversed = 0;
+}
+
+/*********************************************************************
+** Function: circularListAddSorted
+** Description: adds a value after every value not greater than it,
+**              searching from the back so values that mostly arrive
+**              in order are added in O(1)
+**
+** Parameters:  a CircularList and value
+**
+** Pre-Conditions: the list is sorted by LT
+** Post-Conditions: the list is still sorted
+**
+**
+*******************************************************************/
+void circularListAddSorted(struct CircularList* list, TYPE value)
+{
+    assert(list!=0);
+    struct Link * before = list->sentinel;
+    for(;;){
+        struct Link * prev = list->reversed ? before->next : before->prev;
+        if(prev == list->sentinel || !LT(value, prev->value)) break;
+        before = prev;
+        STAT_ADD(list, traversed, 1);
+    }
+    linkBefore(list, createLink(list, value), before);
+    list->size++;
+    STAT_PEAK(list);
+}
+
+/*********************************************************************
+** Function: circularListMerge
+** Description: merges every value of other into list in O(n+m),
+**              leaving other empty. The links are relinked, or for a
+**              pooled list copied and recycled as with
+**              circularListConcat
+**
+** Parameters:  two CircularLists
+**
+** Pre-Conditions: the lists are different and both sorted by LT
+** Post-Conditions: list is sorted, values equal to one of list's come
+**                  after it, other is empty
+**
+*******************************************************************/
+void circularListMerge(struct CircularList* list, struct CircularList* other)
+{
+    assert(list!=0 && other!=0 && list!=other);
+    int relink = !list->pooled && !other->pooled;
+
+    struct Link * at = frontLink(list);
+    struct Link * temp = frontLink(other);
+    while(temp != other->sentinel){
+        struct Link * next = other->reversed ? temp->prev : temp->next;
+        while(at != list->sentinel && !LT(temp->value, at->value)){
+            at = list->reversed ? at->prev : at->next;
+        }
+
+        struct Link * link = temp;
+        if(!relink){
+            link = createLink(list, temp->value);
+            freeLink(other, temp);
+        }
+        linkBefore(list, link, at);
+        temp = next;
+    }
+    STAT_ADD(list, traversed, list->size + other->size);
+
+    list->size += other->size;
+    STAT_PEAK(list);
+    other->size = 0;
+    other->sentinel->next = other->sentinel;
+    other->sentinel->prev = other->sentinel;
+}
+
+/*********************************************************************
+** Function: circularListStats
+** Description: copies the list's instrumentation counters; every
+**              counter reads 0 unless the list was built with
+**              CS261_STATS defined
+**
+** Parameters:  a CircularList and where to copy the counters
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: stats holds the counters since the last reset
+**
+**
+*******************************************************************/
+void circularListStats(struct CircularList* list, struct CircularListStats* stats)
+{
+    assert(list!=0 && stats!=0);
+#ifdef CS261_STATS
+    *stats = list->stats;
+#else
+    stats->allocations = 0;
+    stats->frees = 0;
+    stats->traversed = 0;
+    stats->peakSize = 0;
+#endif
+}
+
+/*********************************************************************
+** Function: circularListStatsReset
+** Description: zeroes the list's instrumentation counters, the peak
+**              size starts over from the current size
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the counters read 0
+**
+**
+*******************************************************************/
+void circularListStatsReset(struct CircularList* list)
+{
+    assert(list!=0);
+#ifdef CS261_STATS
+    list->stats.allocations = 0;
+    list->stats.frees = 0;
+    list->stats.traversed = 0;
+    list->stats.peakSize = list->size;
+#endif
+}
+
+/*********************************************************************
+** Function: circularListStatsPrint
+** Description: prints the list's instrumentation counters as one line
+**              of JSON
+**
+** Parameters:  a CircularList
+**
+** Pre-Conditions: the list has been initialized
+** Post-Conditions: the counters have been printed
+**
+**
+*******************************************************************/
+void circularListStatsPrint(struct CircularList* list)
+{
+    struct CircularListStats stats;
+    circularListStats(list, &stats);
+    printf("{\"structure\": \"CircularList\", \"allocations\": %lu, \"frees\": %lu, "
+           "\"traversed\": %lu, \"peak_size\": %d}\n",
+           stats.allocations, stats.frees, stats.traversed, stats.peakSize);
 }
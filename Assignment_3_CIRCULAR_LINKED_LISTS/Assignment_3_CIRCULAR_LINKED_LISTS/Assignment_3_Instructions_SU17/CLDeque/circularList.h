@@ -1,8 +1,18 @@
 #ifndef CIRCULAR_LIST_H
 #define CIRCULAR_LIST_H
 
+// TYPE defaults to double. The flag next to it tells the array backends
+// which vector kernels can scan TYPE: change both together, and build
+// with -DTYPE=int -DCIRCULAR_LIST_TYPE_INT for ints. A flag that does
+// not match TYPE fails to compile, see circularListScan.h.
 #ifndef TYPE
 #define TYPE double
+#define CIRCULAR_LIST_TYPE_DOUBLE
+#endif
+
+// Set when EQ and LT are left at == and <
+#if !defined(LT) && !defined(EQ)
+#define CIRCULAR_LIST_DEFAULT_COMPARE
 #endif
 
 #ifndef LT
@@ -14,11 +24,34 @@
 #endif
 
 struct CircularList;
+struct Link;
+
+// Position in a list for walking it in either direction. index counts
+// from the front, the link backend also keeps the link it is on. A
+// cursor moved past either end is no longer valid, and changing the
+// list any other way than through the cursor may invalidate it.
+struct CircularListCursor
+{
+	struct CircularList* list;
+	struct Link* link;
+	int index;
+};
+
+// Instrumentation counters, only kept when built with CS261_STATS
+struct CircularListStats
+{
+	unsigned long allocations;	// mallocs of links, pages or blocks
+	unsigned long frees;
+	unsigned long traversed;	// links or values visited by Get and Reverse
+	int peakSize;
+};
 
 struct CircularList* circularListCreate();
+struct CircularList* circularListCreatePooled();
 void circularListDestroy(struct CircularList* list);
 void circularListPrint(struct CircularList* list);
 void circularListReverse(struct CircularList* list);
+void circularListReverseLazy(struct CircularList* list);
 
 // Deque interface
 
@@ -26,8 +59,68 @@ void circularListAddFront(struct CircularList* list, TYPE value);
 void circularListAddBack(struct CircularList* list, TYPE value);
 TYPE circularListFront(struct CircularList* list);
 TYPE circularListBack(struct CircularList* list);
+TYPE circularListGet(struct CircularList* list, int index);
 void circularListRemoveFront(struct CircularList* list);
 void circularListRemoveBack(struct CircularList* list);
 int circularListIsEmpty(struct CircularList* list);
 
+// Bulk interface
+
+void circularListAddFrontArray(struct CircularList* list, const TYPE* values, int count);
+void circularListAddBackArray(struct CircularList* list, const TYPE* values, int count);
+int circularListRemoveFrontArray(struct CircularList* list, TYPE* out, int count);
+int circularListRemoveBackArray(struct CircularList* list, TYPE* out, int count);
+int circularListDrain(struct CircularList* list, TYPE* out);
+
+// Search interface, the array backends scan with vector instructions
+// when TYPE is the default double, or int with CIRCULAR_LIST_TYPE_INT,
+// and EQ and LT are left at their defaults. Otherwise they compare with
+// EQ and LT like the link backend. Sum adds values with + on every
+// backend.
+
+int circularListContains(struct CircularList* list, TYPE value);
+int circularListFindIndex(struct CircularList* list, TYPE value);
+int circularListCount(struct CircularList* list, TYPE value);
+TYPE circularListSum(struct CircularList* list);
+TYPE circularListMin(struct CircularList* list);
+TYPE circularListMax(struct CircularList* list);
+
+// Cursor interface, removing at a cursor is O(1) on the link backend,
+// moves the shorter side of the list on the block backend, and copies
+// the list into free slots on the file backend unless at either end
+
+void circularListCursorBegin(struct CircularList* list, struct CircularListCursor* cursor);
+void circularListCursorLast(struct CircularList* list, struct CircularListCursor* cursor);
+int circularListCursorValid(struct CircularListCursor* cursor);
+void circularListCursorNext(struct CircularListCursor* cursor);
+void circularListCursorPrev(struct CircularListCursor* cursor);
+TYPE circularListCursorGet(struct CircularListCursor* cursor);
+void circularListCursorRemove(struct CircularListCursor* cursor);
+int circularListForEach(struct CircularList* list, int (*visit)(TYPE value, void* arg), void* arg);
+int circularListRemoveIf(struct CircularList* list, int (*match)(TYPE value, void* arg), void* arg);
+
+// Splice interface, O(1) relinking on the link backend between lists
+// that malloc their links; pooled lists and the array backends copy
+// the values instead
+
+void circularListConcat(struct CircularList* list, struct CircularList* other);
+void circularListSplice(struct CircularListCursor* position, struct CircularListCursor* first,
+                        struct CircularListCursor* last);
+void circularListSplit(struct CircularListCursor* cursor, struct CircularList* other);
+
+// Ordered interface, values compare with LT and equal values keep the
+// order they were added in. The link backend sorts by relinking, the
+// block backend sorts in place without allocating, and the file backend
+// sorts a copy in the ring's free slots, growing the ring if needed
+
+void circularListSort(struct CircularList* list);
+void circularListAddSorted(struct CircularList* list, TYPE value);
+void circularListMerge(struct CircularList* list, struct CircularList* other);
+
+// Instrumentation interface
+
+void circularListStats(struct CircularList* list, struct CircularListStats* stats);
+void circularListStatsReset(struct CircularList* list);
+void circularListStatsPrint(struct CircularList* list);
+
 #endif
\ No newline at end of file
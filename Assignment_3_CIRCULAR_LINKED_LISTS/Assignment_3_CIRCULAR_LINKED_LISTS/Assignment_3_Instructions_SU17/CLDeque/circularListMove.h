@@ -0,0 +1,109 @@
+#ifndef CIRCULAR_LIST_MOVE_H
+#define CIRCULAR_LIST_MOVE_H
+
+// Moving values between lists for the CircularList backends that store
+// values in arrays, where nothing can be relinked. Written against the
+// deque's own bulk calls, so it costs the values moved plus the shorter
+// side of each list around the gap or the insertion point.
+
+#include <stdlib.h>
+#include <assert.h>
+#include "circularList.h"
+
+static inline void reverseValues(TYPE* values, int count)
+{
+    for(int i = 0, j = count - 1; i < j; i++, j--){
+        TYPE temp = values[i];
+        values[i] = values[j];
+        values[j] = temp;
+    }
+}
+
+/*********************************************************************
+** Function: setAside
+**
+** Description: takes the shorter side around index off the list, the
+**              front part in front to back order or the back part in
+**              back to front order
+**
+** Parameters:  a list, its size, an index, room for the values and
+**              where to note which side they came from
+**
+** Pre-Conditions:  0 <= index <= size
+** Post-Conditions: returns how many values were taken, back is set
+**                  when they came off the back
+********************************************************************/
+static inline int setAside(struct CircularList* list, int size, int index, TYPE* out, int* back)
+{
+    *back = index > size - index;
+    if(*back) return circularListRemoveBackArray(list, out, size - index);
+    return circularListRemoveFrontArray(list, out, index);
+}
+
+static inline void putBack(struct CircularList* list, TYPE* values, int count, int back)
+{
+    if(back){
+        reverseValues(values, count);
+        circularListAddBackArray(list, values, count);
+    }
+    else circularListAddFrontArray(list, values, count);
+}
+
+/*********************************************************************
+** Function: moveValues
+**
+** Description: moves count values starting at index first of one list
+**              in front of index position of another, setting aside
+**              whichever side of the gap or the insertion point is
+**              shorter while the values go out or in
+**
+** Parameters:  the list to move from and its size, the index of the
+**              first value and how many, the list to move to and its
+**              size, and the index to insert at, which may be its
+**              size to append
+**
+** Pre-Conditions:  the lists are different and the indexes in range
+** Post-Conditions: the values sit in front of position, in order
+********************************************************************/
+static inline void moveValues(struct CircularList* from, int fromSize, int first, int count,
+                              struct CircularList* to, int toSize, int position)
+{
+    assert(from!=to && count>=0);
+    assert(first>=0 && first+count<=fromSize);
+    assert(position>=0 && position<=toSize);
+    if(count == 0) return;
+
+    // room for the shorter side of both lists
+    int rest = fromSize - first - count;
+    int aside = first < rest ? first : rest;
+    int after = toSize - position;
+    if(aside < (position < after ? position : after)) aside = position < after ? position : after;
+    TYPE* values = malloc(count * sizeof(TYPE));
+    TYPE* side = malloc((aside > 0 ? aside : 1) * sizeof(TYPE));
+    assert(values!=0 && side!=0);
+
+    // out of from, with the shorter side around the values set aside
+    int back = rest < first;
+    int taken;
+    if(back){
+        taken = circularListRemoveBackArray(from, side, rest);
+        circularListRemoveBackArray(from, values, count);
+        reverseValues(values, count);
+    }
+    else {
+        taken = circularListRemoveFrontArray(from, side, first);
+        circularListRemoveFrontArray(from, values, count);
+    }
+    putBack(from, side, taken, back);
+
+    // and into to the same way
+    taken = setAside(to, toSize, position, side, &back);
+    if(back) circularListAddBackArray(to, values, count);
+    else circularListAddFrontArray(to, values, count);
+    putBack(to, side, taken, back);
+
+    free(side);
+    free(values);
+}
+
+#endif
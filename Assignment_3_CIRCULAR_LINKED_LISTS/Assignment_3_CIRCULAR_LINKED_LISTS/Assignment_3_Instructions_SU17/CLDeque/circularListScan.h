@@ -0,0 +1,105 @@
+#ifndef CIRCULAR_LIST_SCAN_H
+#define CIRCULAR_LIST_SCAN_H
+
+// Scans of a contiguous run of TYPE values, shared by the CircularList
+// backends that store values in arrays
+
+#include "circularList.h"
+#include "valueScan.h"
+
+// The vector kernels in valueScan.c compare with == and <, so they are
+// only used when EQ and LT are the defaults and TYPE is one the kernels
+// take. Any other build goes through plain loops using EQ and LT, and
+// sums with + as the link backend does.
+#if defined(CIRCULAR_LIST_DEFAULT_COMPARE) && defined(CIRCULAR_LIST_TYPE_DOUBLE)
+#define SCAN_DOUBLE
+#elif defined(CIRCULAR_LIST_DEFAULT_COMPARE) && defined(CIRCULAR_LIST_TYPE_INT)
+#define SCAN_INT
+#endif
+
+// A type flag left behind when TYPE changes would run the kernels over
+// the wrong values, so the build fails instead
+#ifdef __GNUC__
+#define SCAN_TYPE_IS(T) __builtin_types_compatible_p(TYPE, T)
+#else
+#define SCAN_TYPE_IS(T) (sizeof(TYPE) == sizeof(T))
+#endif
+#if defined(SCAN_DOUBLE)
+typedef char scanTypeIsDouble[SCAN_TYPE_IS(double) ? 1 : -1];
+#elif defined(SCAN_INT)
+typedef char scanTypeIsInt[SCAN_TYPE_IS(int) ? 1 : -1];
+#endif
+
+static inline int findRun(const TYPE* values, int count, TYPE value)
+{
+#if defined(SCAN_DOUBLE)
+    return scanFindDouble((const double*)values, count, value);
+#elif defined(SCAN_INT)
+    return scanFindInt((const int*)values, count, value);
+#else
+    for(int i = 0; i < count; i++){
+        if(EQ(values[i], value)) return i;
+    }
+    return -1;
+#endif
+}
+
+static inline int countRun(const TYPE* values, int count, TYPE value)
+{
+#if defined(SCAN_DOUBLE)
+    return scanCountDouble((const double*)values, count, value);
+#elif defined(SCAN_INT)
+    return scanCountInt((const int*)values, count, value);
+#else
+    int found = 0;
+    for(int i = 0; i < count; i++){
+        if(EQ(values[i], value)) found++;
+    }
+    return found;
+#endif
+}
+
+static inline TYPE sumRun(const TYPE* values, int count)
+{
+#if defined(SCAN_DOUBLE)
+    return scanSumDouble((const double*)values, count);
+#elif defined(SCAN_INT)
+    return scanSumInt((const int*)values, count);
+#else
+    TYPE sum = values[0];
+    for(int i = 1; i < count; i++) sum += values[i];
+    return sum;
+#endif
+}
+
+static inline TYPE minRun(const TYPE* values, int count)
+{
+#if defined(SCAN_DOUBLE)
+    return scanMinDouble((const double*)values, count);
+#elif defined(SCAN_INT)
+    return scanMinInt((const int*)values, count);
+#else
+    TYPE min = values[0];
+    for(int i = 1; i < count; i++){
+        if(LT(values[i], min)) min = values[i];
+    }
+    return min;
+#endif
+}
+
+static inline TYPE maxRun(const TYPE* values, int count)
+{
+#if defined(SCAN_DOUBLE)
+    return scanMaxDouble((const double*)values, count);
+#elif defined(SCAN_INT)
+    return scanMaxInt((const int*)values, count);
+#else
+    TYPE max = values[0];
+    for(int i = 1; i < count; i++){
+        if(LT(max, values[i])) max = values[i];
+    }
+    return max;
+#endif
+}
+
+#endif
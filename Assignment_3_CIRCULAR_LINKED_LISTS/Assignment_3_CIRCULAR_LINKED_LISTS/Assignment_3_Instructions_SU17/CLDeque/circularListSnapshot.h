@@ -0,0 +1,27 @@
+#ifndef CIRCULAR_LIST_SNAPSHOT_H
+#define CIRCULAR_LIST_SNAPSHOT_H
+
+#include "circularList.h"
+#include "snapshotFile.h"
+
+// Snapshot files as described in snapshotFile.h, holding the values
+// front to back
+#define CIRCULAR_LIST_SNAPSHOT_VERSION 1
+
+// Snapshot file mapped read-only, values[0 .. count-1] can be read in
+// place until the snapshot is closed
+struct CircularListSnapshot
+{
+	const TYPE* values;
+	int count;
+	struct SnapshotFile file;
+};
+
+int circularListSave(struct CircularList* list, const char* path);
+struct CircularList* circularListLoad(const char* path);
+
+int circularListSnapshotOpen(const char* path, struct CircularListSnapshot* snapshot);
+void circularListSnapshotClose(struct CircularListSnapshot* snapshot);
+struct CircularList* circularListSnapshotLoad(struct CircularListSnapshot* snapshot);
+
+#endif
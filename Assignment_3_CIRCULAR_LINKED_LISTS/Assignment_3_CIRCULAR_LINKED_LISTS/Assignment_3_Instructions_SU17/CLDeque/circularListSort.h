@@ -0,0 +1,215 @@
+#ifndef CIRCULAR_LIST_SORT_H
+#define CIRCULAR_LIST_SORT_H
+
+// Ordering for the CircularList backends that store values in arrays.
+// The backend passes slot, which returns the address of the value at
+// an index counted from the front. Sorting is a stable in-place merge
+// sort, insertion sorted blocks merged by rotation (SymMerge, Kim and
+// Kutzner), in O(n log^2 n) with no allocation.
+
+#include <assert.h>
+#include "circularList.h"
+
+// Values per insertion sorted block
+#define SORT_BLOCK 20
+
+typedef TYPE* (*SlotFunction)(struct CircularList* list, int index);
+
+static inline void swapSlots(struct CircularList* list, SlotFunction slot, int i, int j)
+{
+    TYPE* a = slot(list, i);
+    TYPE* b = slot(list, j);
+    TYPE temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+static inline int lessSlots(struct CircularList* list, SlotFunction slot, int i, int j)
+{
+    return LT(*slot(list, i), *slot(list, j));
+}
+
+static inline void insertionSortSlots(struct CircularList* list, SlotFunction slot, int a, int b)
+{
+    for(int i = a + 1; i < b; i++){
+        for(int j = i; j > a && lessSlots(list, slot, j, j - 1); j--){
+            swapSlots(list, slot, j, j - 1);
+        }
+    }
+}
+
+// Swaps the n values from a with the n values from b
+static inline void swapRange(struct CircularList* list, SlotFunction slot, int a, int b, int n)
+{
+    for(int i = 0; i < n; i++) swapSlots(list, slot, a + i, b + i);
+}
+
+// Turns [a, m) [m, b) into [m, b) [a, m)
+static inline void rotateSlots(struct CircularList* list, SlotFunction slot, int a, int m, int b)
+{
+    int i = m - a;
+    int j = b - m;
+    while(i != j){
+        if(i > j){
+            swapRange(list, slot, m - i, m, j);
+            i -= j;
+        }
+        else {
+            swapRange(list, slot, m - i, m + j - i, i);
+            j -= i;
+        }
+    }
+    swapRange(list, slot, m - i, m, i);
+}
+
+/*********************************************************************
+** Function: symMerge
+**
+** Description: merges the sorted runs [a, m) and [m, b) in place by
+**              rotating the middle into place and merging both halves
+**              again; recursion is O(log n) deep
+**
+** Parameters:  a list, its slot function and the run bounds
+**
+** Pre-Conditions:  a < m < b, both runs sorted by LT
+** Post-Conditions: [a, b) is sorted, equal values keep their order
+********************************************************************/
+static inline void symMerge(struct CircularList* list, SlotFunction slot, int a, int m, int b)
+{
+    // a run of one value is placed with a binary search
+    if(m - a == 1){
+        int i = m, j = b;
+        while(i < j){
+            int h = (i + j) / 2;
+            if(lessSlots(list, slot, h, a)) i = h + 1;
+            else j = h;
+        }
+        for(int k = a; k < i - 1; k++) swapSlots(list, slot, k, k + 1);
+        return;
+    }
+    if(b - m == 1){
+        int i = a, j = m;
+        while(i < j){
+            int h = (i + j) / 2;
+            if(!lessSlots(list, slot, m, h)) i = h + 1;
+            else j = h;
+        }
+        for(int k = m; k > i; k--) swapSlots(list, slot, k, k - 1);
+        return;
+    }
+
+    int mid = (a + b) / 2;
+    int n = mid + m;
+    int start, r;
+    if(m > mid){
+        start = n - b;
+        r = mid;
+    }
+    else {
+        start = a;
+        r = m;
+    }
+    int p = n - 1;
+    while(start < r){
+        int c = (start + r) / 2;
+        if(!lessSlots(list, slot, p - c, c)) start = c + 1;
+        else r = c;
+    }
+
+    int end = n - start;
+    if(start < m && m < end) rotateSlots(list, slot, start, m, end);
+    if(a < start && start < mid) symMerge(list, slot, a, start, mid);
+    if(mid < end && end < b) symMerge(list, slot, mid, end, b);
+}
+
+static inline void sortSlots(struct CircularList* list, SlotFunction slot, int size)
+{
+    int a = 0;
+    for(; a + SORT_BLOCK <= size; a += SORT_BLOCK){
+        insertionSortSlots(list, slot, a, a + SORT_BLOCK);
+    }
+    insertionSortSlots(list, slot, a, size);
+
+    for(int block = SORT_BLOCK; block < size; block *= 2){
+        for(a = 0; a + 2 * block <= size; a += 2 * block){
+            symMerge(list, slot, a, a + block, a + 2 * block);
+        }
+        if(a + block < size) symMerge(list, slot, a, a + block, size);
+    }
+}
+
+/*********************************************************************
+** Function: addSortedSlots
+**
+** Description: adds a value after every value not greater than it,
+**              found with a binary search, moving the shorter side of
+**              the list over by one to make room
+**
+** Parameters:  a list, its slot function, its size and the value
+**
+** Pre-Conditions:  the list is sorted by LT
+** Post-Conditions: the list is still sorted
+********************************************************************/
+static inline void addSortedSlots(struct CircularList* list, SlotFunction slot, int size, TYPE value)
+{
+    int i = 0, j = size;
+    while(i < j){
+        int h = (i + j) / 2;
+        if(LT(value, *slot(list, h))) j = h;
+        else i = h + 1;
+    }
+
+    if(i < size - i){
+        circularListAddFront(list, value);
+        for(int k = 0; k < i; k++) *slot(list, k) = *slot(list, k + 1);
+    }
+    else {
+        circularListAddBack(list, value);
+        for(int k = size; k > i; k--) *slot(list, k) = *slot(list, k - 1);
+    }
+    *slot(list, i) = value;
+}
+
+/*********************************************************************
+** Function: mergeSorted
+**
+** Description: merges other into list in O(n+m) with the deque calls
+**              alone: the smaller front goes on list's back until
+**              either list's original values run out, then list's
+**              leftovers are rotated round to the back and the rest
+**              of other follows
+**
+** Parameters:  two lists and list's size
+**
+** Pre-Conditions:  the lists are different and both sorted by LT
+** Post-Conditions: list is sorted, other is empty
+********************************************************************/
+static inline void mergeSorted(struct CircularList* list, int size, struct CircularList* other)
+{
+    assert(list!=other);
+    int left = size;
+    while(left > 0 && !circularListIsEmpty(other)){
+        TYPE mine = circularListFront(list);
+        TYPE theirs = circularListFront(other);
+        if(LT(theirs, mine)){
+            circularListAddBack(list, theirs);
+            circularListRemoveFront(other);
+        }
+        else {
+            circularListAddBack(list, mine);
+            circularListRemoveFront(list);
+            left--;
+        }
+    }
+    for(; left > 0; left--){
+        TYPE mine = circularListFront(list);
+        circularListAddBack(list, mine);
+        circularListRemoveFront(list);
+    }
+    while(!circularListIsEmpty(other)){
+        circularListAddBack(list, circularListFront(other));
+        circularListRemoveFront(other);
+    }
+}
+
+#endif
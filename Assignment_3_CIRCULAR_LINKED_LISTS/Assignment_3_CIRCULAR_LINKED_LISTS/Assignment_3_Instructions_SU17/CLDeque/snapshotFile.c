@@ -0,0 +1,261 @@
+/***********************************************************
+* Filename:                     snapshotFile.c
+*
+* Overview:
+*   This file contains the function definitions for the binary
+*   snapshot files behind circularListSnapshot.c and LLDeque's
+*   linkedListSnapshot.c; Worksheets_AVL_Heaps keeps a copy of
+*   its own for avlFile.c. It writes and checks the header,
+*   saves through a temporary file, and maps a saved file
+*   read-only. The structures only walk their values out and
+*   copy them back in.
+*
+*
+* Input:
+*   A snapshot file path
+*
+* Output:
+*   A snapshot file
+************************************************************/
+
+// open, fstat, fsync and mmap are POSIX, not C99
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snapshotFile.h"
+
+// Written as 0x01020304, reads back differently on the other byte order
+#define SNAPSHOT_BYTE_ORDER 0x01020304u
+
+// Bytes buffered per write while saving
+#define SAVE_BUFFER 8192
+
+struct SnapshotHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t valueSize;
+	uint32_t byteOrder;
+	uint32_t reserved;
+	uint64_t count;
+};
+
+struct SnapshotWriter
+{
+	FILE* file;
+	size_t valueSize;
+	size_t used;
+	uint64_t count;
+	int failed;
+	char buffer[SAVE_BUFFER];
+};
+
+
+/*********************************************************************
+** Function: fillHeader
+**
+** Description: fills in a header for the format and count
+**
+** Parameters: the header, format and value count
+**
+** Pre-Conditions:  the magic is at most 7 characters
+** Post-Conditions: the header is ready to write
+*********************************************************************/
+static void fillHeader(struct SnapshotHeader* header, const struct SnapshotFormat* format, uint64_t count)
+{
+    assert(strlen(format->magic) < sizeof(header->magic));
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, format->magic, strlen(format->magic));
+    header->version = format->version;
+    header->valueSize = format->valueSize;
+    header->byteOrder = SNAPSHOT_BYTE_ORDER;
+    header->count = count;
+}
+
+/*********************************************************************
+** Function: flush
+**
+** Description: writes out the values buffered by a save
+**
+** Parameters: the writer
+**
+** Pre-Conditions:  the file is open
+** Post-Conditions: the buffer is empty, failed is set if the write
+**                  came up short
+*********************************************************************/
+static void flush(struct SnapshotWriter* writer)
+{
+    if(fwrite(writer->buffer, 1, writer->used, writer->file) != writer->used){
+        writer->failed = 1;
+    }
+    writer->used = 0;
+}
+
+/*********************************************************************
+** Function: snapshotWrite
+**
+** Description: buffers one value, called by a walk for each value in
+**              order
+**
+** Parameters: the writer and a value of the format's valueSize
+**
+** Pre-Conditions:  called from the walk given to snapshotFileSave
+** Post-Conditions: returns 0 once a write has failed, so the walk can
+**                  stop early
+*********************************************************************/
+int snapshotWrite(struct SnapshotWriter* writer, const void* value)
+{
+    assert(writer!=0 && value!=0);
+    if(writer->used + writer->valueSize > SAVE_BUFFER) flush(writer);
+    memcpy(writer->buffer + writer->used, value, writer->valueSize);
+    writer->used += writer->valueSize;
+    writer->count++;
+    return !writer->failed;
+}
+
+/*********************************************************************
+** Function: snapshotFileSave
+**
+** Description: writes a snapshot to path with the values the walk
+**              passes to snapshotWrite. The file is written and synced
+**              under a temporary name, then renamed over path, so
+**              after a crash or power loss path holds the old snapshot
+**              or the new one, never half of one
+**
+** Parameters: a file path, the format, and the walk and its argument
+**
+** Pre-Conditions:  the format's valueSize fits the save buffer
+** Post-Conditions: returns 0 on success, or -1 with errno set
+*********************************************************************/
+int snapshotFileSave(const char* path, const struct SnapshotFormat* format,
+                     void (*walk)(struct SnapshotWriter* writer, void* arg), void* arg)
+{
+    assert(path!=0 && format!=0 && walk!=0);
+    assert(format->valueSize > 0 && format->valueSize <= SAVE_BUFFER);
+
+    char temp[4096];
+    if(snprintf(temp, sizeof(temp), "%s.tmp", path) >= (int)sizeof(temp)){
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+
+    struct SnapshotWriter* writer = malloc(sizeof(struct SnapshotWriter));
+    assert(writer!=0);
+    writer->file = fopen(temp, "wb");
+    if(writer->file == 0){
+        free(writer);
+        return -1;
+    }
+    writer->valueSize = format->valueSize;
+    writer->used = 0;
+    writer->count = 0;
+    writer->failed = 0;
+
+    // the count is only known after the walk, so the header is written
+    // twice, once to hold its place and again once the values are out
+    struct SnapshotHeader header;
+    fillHeader(&header, format, 0);
+
+    int failed = fwrite(&header, sizeof(header), 1, writer->file) != 1;
+    if(!failed){
+        walk(writer, arg);
+        flush(writer);
+        fillHeader(&header, format, writer->count);
+        failed = writer->failed || fseek(writer->file, 0, SEEK_SET) != 0
+              || fwrite(&header, sizeof(header), 1, writer->file) != 1
+              || fflush(writer->file) != 0 || fsync(fileno(writer->file)) != 0;
+    }
+    failed = fclose(writer->file) != 0 || failed;
+    free(writer);
+
+    if(failed || rename(temp, path) != 0){
+        int error = errno;
+        remove(temp);
+        errno = error;
+        return -1;
+    }
+    return 0;
+}
+
+/*********************************************************************
+** Function: snapshotFileOpen
+**
+** Description: maps a snapshot file read-only and checks that it was
+**              saved in this format by a program with the same value
+**              size and byte order
+**
+** Parameters: a file path, the format, and the file to fill in
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: returns 0 with the file open, or -1 with errno set,
+**                  EINVAL if the file is not a usable snapshot
+*********************************************************************/
+int snapshotFileOpen(const char* path, const struct SnapshotFormat* format, struct SnapshotFile* file)
+{
+    assert(path!=0 && format!=0 && file!=0);
+
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) return -1;
+    struct stat status;
+    if(fstat(fd, &status) != 0){
+        close(fd);
+        return -1;
+    }
+    size_t length = (size_t)status.st_size;
+    if(length < sizeof(struct SnapshotHeader)){
+        close(fd);
+        errno = EINVAL;
+        return -1;
+    }
+
+    void* map = mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED) return -1;
+
+    struct SnapshotHeader expected;
+    fillHeader(&expected, format, 0);
+    const struct SnapshotHeader* header = map;
+    if(memcmp(header->magic, expected.magic, sizeof(expected.magic)) != 0
+       || header->version != expected.version
+       || header->valueSize != expected.valueSize
+       || header->byteOrder != expected.byteOrder
+       || header->count > (uint64_t)(length - sizeof(struct SnapshotHeader)) / format->valueSize
+       || header->count > INT32_MAX){
+        munmap(map, length);
+        errno = EINVAL;
+        return -1;
+    }
+
+    file->values = (const char*)map + sizeof(struct SnapshotHeader);
+    file->count = (int)header->count;
+    file->map = map;
+    file->length = length;
+    return 0;
+}
+
+/*********************************************************************
+** Function: snapshotFileClose
+**
+** Description: unmaps a snapshot file
+**
+** Parameters: an open file
+**
+** Pre-Conditions:  the file was opened by snapshotFileOpen
+** Post-Conditions: the file's values may no longer be read
+*********************************************************************/
+void snapshotFileClose(struct SnapshotFile* file)
+{
+    assert(file!=0 && file->map!=0);
+    munmap(file->map, file->length);
+    file->map = 0;
+    file->values = 0;
+    file->count = 0;
+}
@@ -0,0 +1,39 @@
+#ifndef SNAPSHOT_FILE_H
+#define SNAPSHOT_FILE_H
+
+// Binary snapshot files shared by the list snapshots: a 32 byte
+// header, then count values in the byte order and value size of the
+// program that saved them. Each structure supplies its own format and
+// the walk that writes its values out.
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct SnapshotFormat
+{
+	const char* magic;	// at most 7 characters
+	uint32_t version;
+	uint32_t valueSize;
+};
+
+// Snapshot file mapped read-only, values[0 .. count-1] can be read in
+// place until the file is closed
+struct SnapshotFile
+{
+	const void* values;
+	int count;
+	void* map;
+	size_t length;
+};
+
+// Buffers values on their way to the file during snapshotFileSave
+struct SnapshotWriter;
+
+int snapshotFileSave(const char* path, const struct SnapshotFormat* format,
+                     void (*walk)(struct SnapshotWriter* writer, void* arg), void* arg);
+int snapshotWrite(struct SnapshotWriter* writer, const void* value);
+
+int snapshotFileOpen(const char* path, const struct SnapshotFormat* format, struct SnapshotFile* file);
+void snapshotFileClose(struct SnapshotFile* file);
+
+#endif
@@ -0,0 +1,607 @@
+/***********************************************************
+* Filename:                     valueScan.c
+*
+* Overview:
+*   This file contains search and reduction kernels over
+*   contiguous runs of doubles or ints: find, count, sum, min
+*   and max. Every kernel is written three times, for AVX2,
+*   for SSE4.1 and as a plain loop, and each call checks the
+*   CPU to choose one. The vector sums add in lanes, so a sum
+*   of doubles may round differently than a left to right
+*   loop.
+*
+*
+* Input:
+*   No input is required.
+*
+* Output:
+*   No output
+************************************************************/
+
+#include <assert.h>
+#include "valueScan.h"
+
+#if !defined(SCAN_SCALAR_ONLY) && (defined(__x86_64__) || defined(__i386__))
+#define SCAN_X86
+#include <immintrin.h>
+
+// kernels built for a wider instruction set than the rest of the file,
+// only called after __builtin_cpu_supports says the CPU has it
+#define AVX2 __attribute__((target("avx2")))
+#define SSE41 __attribute__((target("sse4.1")))
+
+#define HAVE_AVX2() __builtin_cpu_supports("avx2")
+#define HAVE_SSE41() __builtin_cpu_supports("sse4.1")
+#endif
+
+
+// Plain loops, used when the CPU has neither vector path and for the
+// values left over after the last full vector
+
+static int findDoubleScalar(const double* values, int first, int count, double value)
+{
+    for(int i = first; i < count; i++){
+        if(values[i] == value) return i;
+    }
+    return -1;
+}
+
+static int countDoubleScalar(const double* values, int first, int count, double value)
+{
+    int found = 0;
+    for(int i = first; i < count; i++) found += values[i] == value;
+    return found;
+}
+
+static double sumDoubleScalar(const double* values, int first, int count, double sum)
+{
+    for(int i = first; i < count; i++) sum += values[i];
+    return sum;
+}
+
+static double minDoubleScalar(const double* values, int first, int count, double min)
+{
+    for(int i = first; i < count; i++){
+        if(values[i] < min) min = values[i];
+    }
+    return min;
+}
+
+static double maxDoubleScalar(const double* values, int first, int count, double max)
+{
+    for(int i = first; i < count; i++){
+        if(max < values[i]) max = values[i];
+    }
+    return max;
+}
+
+static int findIntScalar(const int* values, int first, int count, int value)
+{
+    for(int i = first; i < count; i++){
+        if(values[i] == value) return i;
+    }
+    return -1;
+}
+
+static int countIntScalar(const int* values, int first, int count, int value)
+{
+    int found = 0;
+    for(int i = first; i < count; i++) found += values[i] == value;
+    return found;
+}
+
+// unsigned so an overflowing sum wraps the same way the vector lanes do
+static int sumIntScalar(const int* values, int first, int count, int sum)
+{
+    unsigned int total = (unsigned int)sum;
+    for(int i = first; i < count; i++) total += (unsigned int)values[i];
+    return (int)total;
+}
+
+static int minIntScalar(const int* values, int first, int count, int min)
+{
+    for(int i = first; i < count; i++){
+        if(values[i] < min) min = values[i];
+    }
+    return min;
+}
+
+static int maxIntScalar(const int* values, int first, int count, int max)
+{
+    for(int i = first; i < count; i++){
+        if(max < values[i]) max = values[i];
+    }
+    return max;
+}
+
+#ifdef SCAN_X86
+
+// AVX2 kernels, 4 doubles or 8 ints per vector. Find and count look at
+// two vectors per step so the loop branch is taken half as often.
+
+static AVX2 int findDoubleAVX2(const double* values, int count, double value)
+{
+    __m256d key = _mm256_set1_pd(value);
+    int i = 0;
+    for(; i + 8 <= count; i += 8){
+        int low = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(values + i), key, _CMP_EQ_OQ));
+        int high = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(values + i + 4), key, _CMP_EQ_OQ));
+        int mask = low | high << 4;
+        if(mask != 0) return i + __builtin_ctz(mask);
+    }
+    return findDoubleScalar(values, i, count, value);
+}
+
+static AVX2 int countDoubleAVX2(const double* values, int count, double value)
+{
+    __m256d key = _mm256_set1_pd(value);
+    // every lane that matches is all ones, -1, so subtracting counts it
+    __m256i counts = _mm256_setzero_si256();
+    int i = 0;
+    for(; i + 4 <= count; i += 4){
+        __m256d equal = _mm256_cmp_pd(_mm256_loadu_pd(values + i), key, _CMP_EQ_OQ);
+        counts = _mm256_sub_epi64(counts, _mm256_castpd_si256(equal));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, counts);
+    int found = (int)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    return found + countDoubleScalar(values, i, count, value);
+}
+
+static AVX2 double sumDoubleAVX2(const double* values, int count)
+{
+    // two accumulators so each add does not wait on the one before it
+    __m256d even = _mm256_setzero_pd(), odd = _mm256_setzero_pd();
+    int i = 0;
+    for(; i + 8 <= count; i += 8){
+        even = _mm256_add_pd(even, _mm256_loadu_pd(values + i));
+        odd = _mm256_add_pd(odd, _mm256_loadu_pd(values + i + 4));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(even, odd));
+    return sumDoubleScalar(values, i, count, (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+}
+
+static AVX2 double minDoubleAVX2(const double* values, int count)
+{
+    if(count < 4) return minDoubleScalar(values, 1, count, values[0]);
+    __m256d min = _mm256_loadu_pd(values);
+    int i = 4;
+    for(; i + 4 <= count; i += 4){
+        min = _mm256_min_pd(_mm256_loadu_pd(values + i), min);
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, min);
+    return minDoubleScalar(values, i, count, minDoubleScalar(lanes, 1, 4, lanes[0]));
+}
+
+static AVX2 double maxDoubleAVX2(const double* values, int count)
+{
+    if(count < 4) return maxDoubleScalar(values, 1, count, values[0]);
+    __m256d max = _mm256_loadu_pd(values);
+    int i = 4;
+    for(; i + 4 <= count; i += 4){
+        max = _mm256_max_pd(_mm256_loadu_pd(values + i), max);
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, max);
+    return maxDoubleScalar(values, i, count, maxDoubleScalar(lanes, 1, 4, lanes[0]));
+}
+
+static AVX2 int findIntAVX2(const int* values, int count, int value)
+{
+    __m256i key = _mm256_set1_epi32(value);
+    int i = 0;
+    for(; i + 16 <= count; i += 16){
+        __m256i low = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(values + i)), key);
+        __m256i high = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(values + i + 8)), key);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(low))
+                 | _mm256_movemask_ps(_mm256_castsi256_ps(high)) << 8;
+        if(mask != 0) return i + __builtin_ctz(mask);
+    }
+    return findIntScalar(values, i, count, value);
+}
+
+static AVX2 int countIntAVX2(const int* values, int count, int value)
+{
+    __m256i key = _mm256_set1_epi32(value);
+    __m256i counts = _mm256_setzero_si256();
+    int i = 0;
+    for(; i + 8 <= count; i += 8){
+        __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(values + i)), key);
+        counts = _mm256_sub_epi32(counts, equal);
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, counts);
+    int found = 0;
+    for(int lane = 0; lane < 8; lane++) found += lanes[lane];
+    return found + countIntScalar(values, i, count, value);
+}
+
+static AVX2 int sumIntAVX2(const int* values, int count)
+{
+    __m256i even = _mm256_setzero_si256(), odd = _mm256_setzero_si256();
+    int i = 0;
+    for(; i + 16 <= count; i += 16){
+        even = _mm256_add_epi32(even, _mm256_loadu_si256((const __m256i*)(values + i)));
+        odd = _mm256_add_epi32(odd, _mm256_loadu_si256((const __m256i*)(values + i + 8)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, _mm256_add_epi32(even, odd));
+    return sumIntScalar(values, i, count, sumIntScalar(lanes, 0, 8, 0));
+}
+
+static AVX2 int minIntAVX2(const int* values, int count)
+{
+    if(count < 8) return minIntScalar(values, 1, count, values[0]);
+    __m256i min = _mm256_loadu_si256((const __m256i*)values);
+    int i = 8;
+    for(; i + 8 <= count; i += 8){
+        min = _mm256_min_epi32(min, _mm256_loadu_si256((const __m256i*)(values + i)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, min);
+    return minIntScalar(values, i, count, minIntScalar(lanes, 1, 8, lanes[0]));
+}
+
+static AVX2 int maxIntAVX2(const int* values, int count)
+{
+    if(count < 8) return maxIntScalar(values, 1, count, values[0]);
+    __m256i max = _mm256_loadu_si256((const __m256i*)values);
+    int i = 8;
+    for(; i + 8 <= count; i += 8){
+        max = _mm256_max_epi32(max, _mm256_loadu_si256((const __m256i*)(values + i)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, max);
+    return maxIntScalar(values, i, count, maxIntScalar(lanes, 1, 8, lanes[0]));
+}
+
+// SSE4.1 kernels, 2 doubles or 4 ints per vector
+
+static SSE41 int findDoubleSSE41(const double* values, int count, double value)
+{
+    __m128d key = _mm_set1_pd(value);
+    int i = 0;
+    for(; i + 4 <= count; i += 4){
+        int low = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(values + i), key));
+        int high = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(values + i + 2), key));
+        int mask = low | high << 2;
+        if(mask != 0) return i + __builtin_ctz(mask);
+    }
+    return findDoubleScalar(values, i, count, value);
+}
+
+static SSE41 int countDoubleSSE41(const double* values, int count, double value)
+{
+    __m128d key = _mm_set1_pd(value);
+    __m128i counts = _mm_setzero_si128();
+    int i = 0;
+    for(; i + 2 <= count; i += 2){
+        __m128d equal = _mm_cmpeq_pd(_mm_loadu_pd(values + i), key);
+        counts = _mm_sub_epi64(counts, _mm_castpd_si128(equal));
+    }
+    long long lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, counts);
+    return (int)(lanes[0] + lanes[1]) + countDoubleScalar(values, i, count, value);
+}
+
+static SSE41 double sumDoubleSSE41(const double* values, int count)
+{
+    __m128d even = _mm_setzero_pd(), odd = _mm_setzero_pd();
+    int i = 0;
+    for(; i + 4 <= count; i += 4){
+        even = _mm_add_pd(even, _mm_loadu_pd(values + i));
+        odd = _mm_add_pd(odd, _mm_loadu_pd(values + i + 2));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(even, odd));
+    return sumDoubleScalar(values, i, count, lanes[0] + lanes[1]);
+}
+
+static SSE41 double minDoubleSSE41(const double* values, int count)
+{
+    if(count < 2) return values[0];
+    __m128d min = _mm_loadu_pd(values);
+    int i = 2;
+    for(; i + 2 <= count; i += 2){
+        min = _mm_min_pd(_mm_loadu_pd(values + i), min);
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, min);
+    return minDoubleScalar(values, i, count, minDoubleScalar(lanes, 1, 2, lanes[0]));
+}
+
+static SSE41 double maxDoubleSSE41(const double* values, int count)
+{
+    if(count < 2) return values[0];
+    __m128d max = _mm_loadu_pd(values);
+    int i = 2;
+    for(; i + 2 <= count; i += 2){
+        max = _mm_max_pd(_mm_loadu_pd(values + i), max);
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, max);
+    return maxDoubleScalar(values, i, count, maxDoubleScalar(lanes, 1, 2, lanes[0]));
+}
+
+static SSE41 int findIntSSE41(const int* values, int count, int value)
+{
+    __m128i key = _mm_set1_epi32(value);
+    int i = 0;
+    for(; i + 8 <= count; i += 8){
+        __m128i low = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(values + i)), key);
+        __m128i high = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(values + i + 4)), key);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(low)) | _mm_movemask_ps(_mm_castsi128_ps(high)) << 4;
+        if(mask != 0) return i + __builtin_ctz(mask);
+    }
+    return findIntScalar(values, i, count, value);
+}
+
+static SSE41 int countIntSSE41(const int* values, int count, int value)
+{
+    __m128i key = _mm_set1_epi32(value);
+    __m128i counts = _mm_setzero_si128();
+    int i = 0;
+    for(; i + 4 <= count; i += 4){
+        __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(values + i)), key);
+        counts = _mm_sub_epi32(counts, equal);
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, counts);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + countIntScalar(values, i, count, value);
+}
+
+static SSE41 int sumIntSSE41(const int* values, int count)
+{
+    __m128i even = _mm_setzero_si128(), odd = _mm_setzero_si128();
+    int i = 0;
+    for(; i + 8 <= count; i += 8){
+        even = _mm_add_epi32(even, _mm_loadu_si128((const __m128i*)(values + i)));
+        odd = _mm_add_epi32(odd, _mm_loadu_si128((const __m128i*)(values + i + 4)));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, _mm_add_epi32(even, odd));
+    return sumIntScalar(values, i, count, sumIntScalar(lanes, 0, 4, 0));
+}
+
+static SSE41 int minIntSSE41(const int* values, int count)
+{
+    if(count < 4) return minIntScalar(values, 1, count, values[0]);
+    __m128i min = _mm_loadu_si128((const __m128i*)values);
+    int i = 4;
+    for(; i + 4 <= count; i += 4){
+        min = _mm_min_epi32(min, _mm_loadu_si128((const __m128i*)(values + i)));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, min);
+    return minIntScalar(values, i, count, minIntScalar(lanes, 1, 4, lanes[0]));
+}
+
+static SSE41 int maxIntSSE41(const int* values, int count)
+{
+    if(count < 4) return maxIntScalar(values, 1, count, values[0]);
+    __m128i max = _mm_loadu_si128((const __m128i*)values);
+    int i = 4;
+    for(; i + 4 <= count; i += 4){
+        max = _mm_max_epi32(max, _mm_loadu_si128((const __m128i*)(values + i)));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, max);
+    return maxIntScalar(values, i, count, maxIntScalar(lanes, 1, 4, lanes[0]));
+}
+
+#endif
+
+/*********************************************************************
+** Function: scanPath
+**
+** Description: names the path the kernels take on this CPU
+**
+** Parameters:  NONE
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: returns "avx2", "sse4.1" or "scalar"
+********************************************************************/
+const char* scanPath()
+{
+#ifdef SCAN_X86
+    if(HAVE_AVX2()) return "avx2";
+    if(HAVE_SSE41()) return "sse4.1";
+#endif
+    return "scalar";
+}
+
+/*********************************************************************
+** Function: scanFindDouble
+**
+** Description: finds the first value equal to value
+**
+** Parameters:  the values, how many there are and the value to find
+**
+** Pre-Conditions:  values holds count doubles
+** Post-Conditions: returns the index of the first match or -1
+********************************************************************/
+int scanFindDouble(const double* values, int count, double value)
+{
+#ifdef SCAN_X86
+    if(HAVE_AVX2()) return findDoubleAVX2(values, count, value);
+    if(HAVE_SSE41()) return findDoubleSSE41(values, count, value);
+#endif
+    return findDoubleScalar(values, 0, count, value);
+}
+
+/*********************************************************************
+** Function: scanCountDouble
+**
+** Description: counts the values equal to value
+**
+** Parameters:  the values, how many there are and the value to count
+**
+** Pre-Conditions:  values holds count doubles
+** Post-Conditions: returns the number of matches
+********************************************************************/
+int scanCountDouble(const double* values, int count, double value)
+{
+#ifdef SCAN_X86
+    if(HAVE_AVX2()) return countDoubleAVX2(values, count, value);
+    if(HAVE_SSE41()) return countDoubleSSE41(values, count, value);
+#endif
+    return countDoubleScalar(values, 0, count, value);
+}
+
+/*********************************************************************
+** Function: scanSumDouble
+**
+** Description: adds up the values
+**
+** Parameters:  the values and how many there are
+**
+** Pre-Conditions:  values holds count doubles
+** Post-Conditions: returns the sum, 0 if count is 0
+********************************************************************/
+double scanSumDouble(const double* values, int count)
+{
+#ifdef SCAN_X86
+    if(HAVE_AVX2()) return sumDoubleAVX2(values, count);
+    if(HAVE_SSE41()) return sumDoubleSSE41(values, count);
+#endif
+    return sumDoubleScalar(values, 0, count, 0);
+}
+
+/*********************************************************************
+** Function: scanMinDouble
+**
+** Description: finds the smallest value
+**
+** Parameters:  the values and how many there are
+**
+** Pre-Conditions:  values holds count doubles, count is positive
+** Post-Conditions: returns the smallest value
+********************************************************************/
+double scanMinDouble(const double* values, int count)
+{
+    assert(count > 0);
+#ifdef SCAN_X86
+    if(HAVE_AVX2()) return minDoubleAVX2(values, count);
+    if(HAVE_SSE41()) return minDoubleSSE41(values, count);
+#endif
+    return minDoubleScalar(values, 1, count, values[0]);
+}
+
+/*********************************************************************
+** Function: scanMaxDouble
+**
+** Description: finds the largest value
+**
+** Parameters:  the values and how many there are
+**
+** Pre-Conditions:  values holds count doubles, count is positive
+** Post-Conditions: returns the largest value
+********************************************************************/
+double scanMaxDouble(const double* values, int count)
+{
+    assert(count > 0);
+#ifdef SCAN_X86
+    if(HAVE_AVX2()) return maxDoubleAVX2(values, count);
+    if(HAVE_SSE41()) return maxDoubleSSE41(values, count);
+#endif
+    return maxDoubleScalar(values, 1, count, values[0]);
+}
+
+/*********************************************************************
+** Function: scanFindInt
+**
+** Description: finds the first value equal to value
+**
+** Parameters:  the values, how many there are and the value to find
+**
+** Pre-Conditions:  values holds count ints
+** Post-Conditions: returns the index of the first match or -1
+********************************************************************/
+int scanFindInt(const int* values, int count, int value)
+{
+#ifdef SCAN_X86
+    if(HAVE_AVX2()) return findIntAVX2(values, count, value);
+    if(HAVE_SSE41()) return findIntSSE41(values, count, value);
+#endif
+    return findIntScalar(values, 0, count, value);
+}
+
+/*********************************************************************
+** Function: scanCountInt
+**
+** Description: counts the values equal to value
+**
+** Parameters:  the values, how many there are and the value to count
+**
+** Pre-Conditions:  values holds count ints
+** Post-Conditions: returns the number of matches
+********************************************************************/
+int scanCountInt(const int* values, int count, int value)
+{
+#ifdef SCAN_X86
+    if(HAVE_AVX2()) return countIntAVX2(values, count, value);
+    if(HAVE_SSE41()) return countIntSSE41(values, count, value);
+#endif
+    return countIntScalar(values, 0, count, value);
+}
+
+/*********************************************************************
+** Function: scanSumInt
+**
+** Description: adds up the values, wrapping around on overflow
+**
+** Parameters:  the values and how many there are
+**
+** Pre-Conditions:  values holds count ints
+** Post-Conditions: returns the sum, 0 if count is 0
+********************************************************************/
+int scanSumInt(const int* values, int count)
+{
+#ifdef SCAN_X86
+    if(HAVE_AVX2()) return sumIntAVX2(values, count);
+    if(HAVE_SSE41()) return sumIntSSE41(values, count);
+#endif
+    return sumIntScalar(values, 0, count, 0);
+}
+
+/*********************************************************************
+** Function: scanMinInt
+**
+** Description: finds the smallest value
+**
+** Parameters:  the values and how many there are
+**
+** Pre-Conditions:  values holds count ints, count is positive
+** Post-Conditions: returns the smallest value
+********************************************************************/
+int scanMinInt(const int* values, int count)
+{
+    assert(count > 0);
+#ifdef SCAN_X86
+    if(HAVE_AVX2()) return minIntAVX2(values, count);
+    if(HAVE_SSE41()) return minIntSSE41(values, count);
+#endif
+    return minIntScalar(values, 1, count, values[0]);
+}
+
+/*********************************************************************
+** Function: scanMaxInt
+**
+** Description: finds the largest value
+**
+** Parameters:  the values and how many there are
+**
+** Pre-Conditions:  values holds count ints, count is positive
+** Post-Conditions: returns the largest value
+********************************************************************/
+int scanMaxInt(const int* values, int count)
+{
+    assert(count > 0);
+#ifdef SCAN_X86
+    if(HAVE_AVX2()) return maxIntAVX2(values, count);
+    if(HAVE_SSE41()) return maxIntSSE41(values, count);
+#endif
+    return maxIntScalar(values, 1, count, values[0]);
+}
@@ -0,0 +1,25 @@
+#ifndef VALUE_SCAN_H
+#define VALUE_SCAN_H
+
+// Search and reduction kernels over a contiguous run of values. Each
+// call picks the widest instruction set the CPU has, AVX2 or SSE4.1 on
+// x86, and falls back to plain loops everywhere else. Build with
+// SCAN_SCALAR_ONLY to always take the plain loops.
+
+// Name of the path the kernels take on this CPU, "avx2", "sse4.1" or
+// "scalar"
+const char* scanPath();
+
+int scanFindDouble(const double* values, int count, double value);
+int scanCountDouble(const double* values, int count, double value);
+double scanSumDouble(const double* values, int count);
+double scanMinDouble(const double* values, int count);
+double scanMaxDouble(const double* values, int count);
+
+int scanFindInt(const int* values, int count, int value);
+int scanCountInt(const int* values, int count, int value);
+int scanSumInt(const int* values, int count);
+int scanMinInt(const int* values, int count);
+int scanMaxInt(const int* values, int count);
+
+#endif
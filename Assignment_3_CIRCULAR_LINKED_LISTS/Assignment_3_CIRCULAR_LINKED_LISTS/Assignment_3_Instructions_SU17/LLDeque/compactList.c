@@ -0,0 +1,368 @@
+/***********************************************************
+ * Filename:                     compactList.c
+ *
+ * Overview:
+ *   This file contains the function definitions for a compact
+ *   doubly linked deque. Instead of one malloc per link, the
+ *   values and the next and prev pointers live in three
+ *   parallel arrays indexed by 32 bit slot numbers. Slot 0 is
+ *   the sentinel, and slots that are not in use are threaded
+ *   through next as a free list. The arrays double when they
+ *   fill and only shrink when asked to.
+ *
+ *
+ * Input:
+ *   No input is required.
+ *
+ * Output:
+ *   No output
+ ************************************************************/
+
+#include "compactList.h"
+#include <assert.h>
+#include <stdlib.h>
+
+// Slots, sentinel included, in a new list
+#ifndef INITIAL_SLOTS
+#define INITIAL_SLOTS 16
+#endif
+
+// prev of a slot on the free list, so a stale handle trips an assert
+#define FREE_SLOT UINT32_MAX
+
+struct CompactList
+{
+	TYPE* values;
+	uint32_t* next;
+	uint32_t* prev;
+	uint32_t capacity;	// slots in each array, sentinel included
+	int size;
+	uint32_t freeSlots;	// first free slot, 0 when there is none
+};
+
+
+/*********************************************************************
+** Function: resize
+**
+** Description: gives the three arrays room for capacity slots and
+**              threads any new slots onto the free list, lowest first
+**
+** Parameters: a list and the new number of slots
+**
+** Pre-Conditions:  every slot in use is below capacity
+** Post-Conditions: handles of values in the list are unchanged
+*********************************************************************/
+static void resize(struct CompactList* list, uint32_t capacity)
+{
+    TYPE* values = realloc(list->values, capacity * sizeof(TYPE));
+    uint32_t* next = realloc(list->next, capacity * sizeof(uint32_t));
+    uint32_t* prev = realloc(list->prev, capacity * sizeof(uint32_t));
+    assert(values!=0 && next!=0 && prev!=0);
+    list->values = values;
+    list->next = next;
+    list->prev = prev;
+    
+    for(uint32_t slot = capacity - 1; slot >= list->capacity && slot > 0; slot--){
+        list->next[slot] = list->freeSlots;
+        list->prev[slot] = FREE_SLOT;
+        list->freeSlots = slot;
+    }
+    list->capacity = capacity;
+}
+
+/*********************************************************************
+** Function: takeSlot
+**
+** Description: takes a slot off the free list, doubling the arrays
+**              first when there is none
+**
+** Parameters: a list
+**
+** Pre-Conditions:  list has been created
+** Post-Conditions: the returned slot is the caller's to link in
+*********************************************************************/
+static uint32_t takeSlot(struct CompactList* list)
+{
+    if(list->freeSlots == 0){
+        assert(list->capacity <= UINT32_MAX / 2);
+        resize(list, list->capacity * 2);
+    }
+    uint32_t slot = list->freeSlots;
+    list->freeSlots = list->next[slot];
+    return slot;
+}
+
+/*********************************************************************
+** Function: linkBefore
+**
+** Description: puts a value in a new slot in front of the given one
+**
+** Parameters: a list, a slot in it or the sentinel, and the value
+**
+** Pre-Conditions:  before is in the list
+** Post-Conditions: returns the new slot, size has grown by one
+*********************************************************************/
+static uint32_t linkBefore(struct CompactList* list, uint32_t before, TYPE value)
+{
+    uint32_t slot = takeSlot(list);
+    uint32_t after = list->prev[before];
+    list->values[slot] = value;
+    list->next[slot] = before;
+    list->prev[slot] = after;
+    list->next[after] = slot;
+    list->prev[before] = slot;
+    list->size++;
+    return slot;
+}
+
+/*********************************************************************
+** Function: removeSlot
+**
+** Description: takes a slot out of the list and puts it on the free
+**              list
+**
+** Parameters: a list and slot
+**
+** Pre-Conditions:  slot holds a value of the list
+** Post-Conditions: size has shrunk by one
+*********************************************************************/
+static void removeSlot(struct CompactList* list, uint32_t slot)
+{
+    assert(slot!=0 && slot<list->capacity && list->prev[slot]!=FREE_SLOT);
+    list->next[list->prev[slot]] = list->next[slot];
+    list->prev[list->next[slot]] = list->prev[slot];
+    list->next[slot] = list->freeSlots;
+    list->prev[slot] = FREE_SLOT;
+    list->freeSlots = slot;
+    list->size--;
+}
+
+/*********************************************************************
+** Function: compactListCreate
+**
+** Description: allocates an empty list
+**
+** Parameters: none
+**
+** Pre-Conditions:  none
+** Post-Conditions: returns the list, its sentinel in slot 0
+*********************************************************************/
+struct CompactList* compactListCreate()
+{
+    struct CompactList* list = malloc(sizeof(struct CompactList));
+    assert(list!=0);
+    list->values = 0;
+    list->next = 0;
+    list->prev = 0;
+    list->capacity = 0;
+    list->size = 0;
+    list->freeSlots = 0;
+    resize(list, INITIAL_SLOTS);
+    
+    list->next[0] = 0;
+    list->prev[0] = 0;
+    return list;
+}
+
+void compactListDestroy(struct CompactList* list)
+{
+    assert(list!=0);
+    free(list->values);
+    free(list->next);
+    free(list->prev);
+    free(list);
+}
+
+/*********************************************************************
+** Function: compactListReserve
+**
+** Description: grows the arrays to hold count values at once, so a
+**              list of known size takes no more than it needs
+**
+** Parameters: a list and number of values
+**
+** Pre-Conditions:  count is not negative
+** Post-Conditions: adding up to count values in all will not resize
+*********************************************************************/
+void compactListReserve(struct CompactList* list, int count)
+{
+    assert(list!=0 && count>=0);
+    if((uint32_t)count + 1 > list->capacity) resize(list, (uint32_t)count + 1);
+}
+
+/*********************************************************************
+** Function: compactListShrink
+**
+** Description: gives back the free slots above the highest slot in
+**              use; values are not moved, so handles stay valid and a
+**              list emptied out of order may keep some free slots
+**
+** Parameters: a list
+**
+** Pre-Conditions:  list has been created
+** Post-Conditions: the arrays end just after the highest slot in use
+*********************************************************************/
+void compactListShrink(struct CompactList* list)
+{
+    assert(list!=0);
+    uint32_t capacity = list->capacity;
+    while(capacity > 1 && list->prev[capacity - 1] == FREE_SLOT) capacity--;
+    if(capacity == list->capacity) return;
+    
+    // rebuild the free list from the slots that stay
+    list->freeSlots = 0;
+    for(uint32_t slot = capacity - 1; slot > 0; slot--){
+        if(list->prev[slot] == FREE_SLOT){
+            list->next[slot] = list->freeSlots;
+            list->freeSlots = slot;
+        }
+    }
+    list->capacity = capacity;
+    resize(list, capacity);
+}
+
+int compactListSize(struct CompactList* list)
+{
+    assert(list!=0);
+    return list->size;
+}
+
+int compactListIsEmpty(struct CompactList* list)
+{
+    assert(list!=0);
+    return list->size == 0;
+}
+
+// Bytes held by the list, arrays included
+unsigned long compactListMemory(struct CompactList* list)
+{
+    assert(list!=0);
+    return sizeof(struct CompactList) +
+           (unsigned long)list->capacity * (sizeof(TYPE) + 2 * sizeof(uint32_t));
+}
+
+// Deque interface
+
+uint32_t compactListAddFront(struct CompactList* list, TYPE value)
+{
+    assert(list!=0);
+    return linkBefore(list, list->next[0], value);
+}
+
+uint32_t compactListAddBack(struct CompactList* list, TYPE value)
+{
+    assert(list!=0);
+    return linkBefore(list, 0, value);
+}
+
+TYPE compactListFront(struct CompactList* list)
+{
+    assert(list!=0 && list->size>0);
+    return list->values[list->next[0]];
+}
+
+TYPE compactListBack(struct CompactList* list)
+{
+    assert(list!=0 && list->size>0);
+    return list->values[list->prev[0]];
+}
+
+void compactListRemoveFront(struct CompactList* list)
+{
+    assert(list!=0 && list->size>0);
+    removeSlot(list, list->next[0]);
+}
+
+void compactListRemoveBack(struct CompactList* list)
+{
+    assert(list!=0 && list->size>0);
+    removeSlot(list, list->prev[0]);
+}
+
+// Handle interface
+
+/*********************************************************************
+** Function: compactListInsertBefore
+**
+** Description: adds a value in front of the value with the given
+**              handle, or at the back for handle 0
+**
+** Parameters: a list, a handle or 0, and the value
+**
+** Pre-Conditions:  handle is 0 or belongs to a value in the list
+** Post-Conditions: returns the new value's handle
+*********************************************************************/
+uint32_t compactListInsertBefore(struct CompactList* list, uint32_t handle, TYPE value)
+{
+    assert(list!=0 && handle<list->capacity && list->prev[handle]!=FREE_SLOT);
+    return linkBefore(list, handle, value);
+}
+
+TYPE compactListGet(struct CompactList* list, uint32_t handle)
+{
+    assert(list!=0 && handle!=0 && handle<list->capacity && list->prev[handle]!=FREE_SLOT);
+    return list->values[handle];
+}
+
+/*********************************************************************
+** Function: compactListRemove
+**
+** Description: removes the value with the given handle in O(1); the
+**              handle may be given to a value added later
+**
+** Parameters: a list and handle
+**
+** Pre-Conditions:  handle belongs to a value in the list
+** Post-Conditions: size has shrunk by one
+*********************************************************************/
+void compactListRemove(struct CompactList* list, uint32_t handle)
+{
+    assert(list!=0);
+    removeSlot(list, handle);
+}
+
+uint32_t compactListFirst(struct CompactList* list)
+{
+    assert(list!=0);
+    return list->next[0];
+}
+
+uint32_t compactListLast(struct CompactList* list)
+{
+    assert(list!=0);
+    return list->prev[0];
+}
+
+uint32_t compactListNext(struct CompactList* list, uint32_t handle)
+{
+    assert(list!=0 && handle!=0 && handle<list->capacity && list->prev[handle]!=FREE_SLOT);
+    return list->next[handle];
+}
+
+uint32_t compactListPrev(struct CompactList* list, uint32_t handle)
+{
+    assert(list!=0 && handle!=0 && handle<list->capacity && list->prev[handle]!=FREE_SLOT);
+    return list->prev[handle];
+}
+
+/*********************************************************************
+** Function: compactListForEach
+**
+** Description: calls visit on every value front to back until visit
+**              returns 0
+**
+** Parameters: a list, the visitor and an argument passed to it
+**
+** Pre-Conditions:  visit does not change the list
+** Post-Conditions: returns how many values were visited
+*********************************************************************/
+int compactListForEach(struct CompactList* list, int (*visit)(TYPE value, void* arg), void* arg)
+{
+    assert(list!=0 && visit!=0);
+    int visited = 0;
+    for(uint32_t slot = list->next[0]; slot != 0; slot = list->next[slot]){
+        visited++;
+        if(!visit(list->values[slot], arg)) break;
+    }
+    return visited;
+}
@@ -0,0 +1,46 @@
+#ifndef COMPACT_LIST_H
+#define COMPACT_LIST_H
+
+#include <stdint.h>
+
+#ifndef TYPE
+#define TYPE int
+#endif
+
+// Deque kept as three parallel arrays of values, next and prev slot
+// numbers, about 12 bytes a value for TYPE int instead of a 24 byte
+// link plus its malloc header. Adding a value returns its slot as a
+// handle for removing it later in O(1); a handle stays the same while
+// the value is in the list and 0 is never a value's handle.
+
+struct CompactList;
+
+struct CompactList* compactListCreate();
+void compactListDestroy(struct CompactList* list);
+void compactListReserve(struct CompactList* list, int count);
+void compactListShrink(struct CompactList* list);
+int compactListSize(struct CompactList* list);
+int compactListIsEmpty(struct CompactList* list);
+unsigned long compactListMemory(struct CompactList* list);
+
+// Deque interface
+
+uint32_t compactListAddFront(struct CompactList* list, TYPE value);
+uint32_t compactListAddBack(struct CompactList* list, TYPE value);
+TYPE compactListFront(struct CompactList* list);
+TYPE compactListBack(struct CompactList* list);
+void compactListRemoveFront(struct CompactList* list);
+void compactListRemoveBack(struct CompactList* list);
+
+// Handle interface, First, Next and Prev return 0 past either end
+
+uint32_t compactListInsertBefore(struct CompactList* list, uint32_t handle, TYPE value);
+TYPE compactListGet(struct CompactList* list, uint32_t handle);
+void compactListRemove(struct CompactList* list, uint32_t handle);
+uint32_t compactListFirst(struct CompactList* list);
+uint32_t compactListLast(struct CompactList* list);
+uint32_t compactListNext(struct CompactList* list, uint32_t handle);
+uint32_t compactListPrev(struct CompactList* list, uint32_t handle);
+int compactListForEach(struct CompactList* list, int (*visit)(TYPE value, void* arg), void* arg);
+
+#endif
@@ -0,0 +1,223 @@
+/***********************************************************
+* Filename:                     intrusiveList.h
+*
+* Overview:
+*   An intrusive doubly linked list: callers embed a struct
+*   ListNode in their own structs and link those, so the list
+*   never allocates and reaching an object from its node is
+*   pointer arithmetic instead of another load. Insert, remove
+*   by node and moving a node to another list are all O(1).
+*
+*       struct Job { int id; struct ListNode node; };
+*
+*       struct IntrusiveList ready;
+*       intrusiveListInit(&ready);
+*       struct Job* job = malloc(sizeof(struct Job));
+*       listNodeInit(&job->node);
+*       intrusiveListAddBack(&ready, &job->node);
+*       struct Job* next = LIST_ENTRY(intrusiveListFront(&ready),
+*                                     struct Job, node);
+*
+*   A node must be initialized with listNodeInit before it is
+*   first linked, and is in at most one list at a time. The
+*   list never owns the objects; whoever does must unlink a
+*   node before freeing the object around it.
+************************************************************/
+
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <stddef.h>
+#include <assert.h>
+
+// Link header to embed, both pointers are null while unlinked
+struct ListNode
+{
+	struct ListNode* next;
+	struct ListNode* prev;
+};
+
+// The sentinel lives in the list itself, so a list must not be moved
+// once it has been initialized
+struct IntrusiveList
+{
+	struct ListNode sentinel;
+	int size;
+};
+
+// The object of type TYPE whose MEMBER is the given node
+#define LIST_ENTRY(node, TYPE, MEMBER) \
+	((TYPE*)((char*)(node) - offsetof(TYPE, MEMBER)))
+
+// Walks the nodes front to back, node may not be removed in the body
+#define LIST_FOR_EACH(node, list) \
+	for((node) = (list)->sentinel.next; (node) != &(list)->sentinel; (node) = (node)->next)
+
+// Same, but the body may remove node; spare is another ListNode pointer
+#define LIST_FOR_EACH_SAFE(node, spare, list) \
+	for((node) = (list)->sentinel.next, (spare) = (node)->next; (node) != &(list)->sentinel; \
+	    (node) = (spare), (spare) = (node)->next)
+
+
+static inline void listNodeInit(struct ListNode* node)
+{
+    assert(node!=0);
+    node->next = 0;
+    node->prev = 0;
+}
+
+static inline int listNodeIsLinked(struct ListNode* node)
+{
+    assert(node!=0);
+    return node->next != 0;
+}
+
+static inline void intrusiveListInit(struct IntrusiveList* list)
+{
+    assert(list!=0);
+    list->sentinel.next = &list->sentinel;
+    list->sentinel.prev = &list->sentinel;
+    list->size = 0;
+}
+
+static inline int intrusiveListSize(struct IntrusiveList* list)
+{
+    assert(list!=0);
+    return list->size;
+}
+
+static inline int intrusiveListIsEmpty(struct IntrusiveList* list)
+{
+    assert(list!=0);
+    return list->size == 0;
+}
+
+/*********************************************************************
+** Function: intrusiveListInsertBefore
+**
+** Description: links node in front of position
+**
+** Parameters:  a list, a node in it or its sentinel, and the node
+**              to add
+**
+** Pre-Conditions:  node is not linked into any list
+** Post-Conditions: size has grown by one
+********************************************************************/
+static inline void intrusiveListInsertBefore(struct IntrusiveList* list, struct ListNode* position,
+                                             struct ListNode* node)
+{
+    assert(list!=0 && position!=0 && node!=0);
+    assert(!listNodeIsLinked(node));
+    node->next = position;
+    node->prev = position->prev;
+    position->prev->next = node;
+    position->prev = node;
+    list->size++;
+}
+
+static inline void intrusiveListInsertAfter(struct IntrusiveList* list, struct ListNode* position,
+                                            struct ListNode* node)
+{
+    assert(position!=0);
+    intrusiveListInsertBefore(list, position->next, node);
+}
+
+static inline void intrusiveListAddFront(struct IntrusiveList* list, struct ListNode* node)
+{
+    intrusiveListInsertBefore(list, list->sentinel.next, node);
+}
+
+static inline void intrusiveListAddBack(struct IntrusiveList* list, struct ListNode* node)
+{
+    intrusiveListInsertBefore(list, &list->sentinel, node);
+}
+
+/*********************************************************************
+** Function: intrusiveListRemove
+**
+** Description: unlinks node from the list, the object around it is
+**              left alone
+**
+** Parameters:  a list and one of its nodes
+**
+** Pre-Conditions:  node is linked into this list
+** Post-Conditions: size has shrunk by one, node is unlinked
+********************************************************************/
+static inline void intrusiveListRemove(struct IntrusiveList* list, struct ListNode* node)
+{
+    assert(list!=0 && list->size>0);
+    assert(node!=0 && node!=&list->sentinel && listNodeIsLinked(node));
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    listNodeInit(node);
+    list->size--;
+}
+
+// Front and back return null on an empty list
+
+static inline struct ListNode* intrusiveListFront(struct IntrusiveList* list)
+{
+    assert(list!=0);
+    return list->size > 0 ? list->sentinel.next : 0;
+}
+
+static inline struct ListNode* intrusiveListBack(struct IntrusiveList* list)
+{
+    assert(list!=0);
+    return list->size > 0 ? list->sentinel.prev : 0;
+}
+
+// Next and prev return null past either end
+
+static inline struct ListNode* intrusiveListNext(struct IntrusiveList* list, struct ListNode* node)
+{
+    assert(list!=0 && node!=0);
+    return node->next != &list->sentinel ? node->next : 0;
+}
+
+static inline struct ListNode* intrusiveListPrev(struct IntrusiveList* list, struct ListNode* node)
+{
+    assert(list!=0 && node!=0);
+    return node->prev != &list->sentinel ? node->prev : 0;
+}
+
+static inline struct ListNode* intrusiveListRemoveFront(struct IntrusiveList* list)
+{
+    struct ListNode* node = intrusiveListFront(list);
+    if(node != 0) intrusiveListRemove(list, node);
+    return node;
+}
+
+static inline struct ListNode* intrusiveListRemoveBack(struct IntrusiveList* list)
+{
+    struct ListNode* node = intrusiveListBack(list);
+    if(node != 0) intrusiveListRemove(list, node);
+    return node;
+}
+
+/*********************************************************************
+** Function: intrusiveListMoveFront / intrusiveListMoveBack
+**
+** Description: moves node from one list to the front or back of
+**              another, or of the same one, as for an LRU list
+**
+** Parameters:  the list node is in, the list to move it to, and node
+**
+** Pre-Conditions:  node is linked into from
+** Post-Conditions: node is linked into to
+********************************************************************/
+static inline void intrusiveListMoveFront(struct IntrusiveList* from, struct IntrusiveList* to,
+                                          struct ListNode* node)
+{
+    intrusiveListRemove(from, node);
+    intrusiveListAddFront(to, node);
+}
+
+static inline void intrusiveListMoveBack(struct IntrusiveList* from, struct IntrusiveList* to,
+                                         struct ListNode* node)
+{
+    intrusiveListRemove(from, node);
+    intrusiveListAddBack(to, node);
+}
+
+#endif
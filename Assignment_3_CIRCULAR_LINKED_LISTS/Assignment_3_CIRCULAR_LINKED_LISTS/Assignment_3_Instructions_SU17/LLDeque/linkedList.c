@@ -21,6 +21,28 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+// Number of links carved out of each page of a pooled list
+#ifndef LINK_PAGE_SIZE
+#define LINK_PAGE_SIZE 256
+#endif
+
+// Cache hint for link walks, a no-op on compilers without it
+#ifdef __GNUC__
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) ((void)0)
+#endif
+
+// Instrumentation counters, compiled out unless CS261_STATS is defined
+#ifdef CS261_STATS
+#define STAT_ADD(list, counter, n) ((list)->stats.counter += (n))
+#define STAT_PEAK(list) \
+    do { if((list)->size > (list)->stats.peakSize) (list)->stats.peakSize = (list)->size; } while(0)
+#else
+#define STAT_ADD(list, counter, n) ((void)0)
+#define STAT_PEAK(list) ((void)0)
+#endif
+
 // Double link
 struct Link
 {
@@ -29,12 +51,46 @@ struct Link
 	struct Link* prev;
 };
 
+// Contiguous page of links owned by a pooled list
+struct LinkPage
+{
+	struct LinkPage* next;
+	int count;
+	struct Link links[];
+};
+
+// Slot of a list's hash index, empty when link is null. order grows
+// from front to back so the first of several equal values can be found
+struct IndexEntry
+{
+	struct Link* link;
+	long order;
+};
+
 // Double linked list with front and back sentinels
 struct LinkedList
 {
 	int size;
 	struct Link* frontSentinel;
 	struct Link* backSentinel;
+	
+	// slab allocator state, only used when pooled is set
+	int pooled;
+	struct LinkPage* pages;
+	struct Link* freeLinks;
+	int freeCount;
+	
+	// open addressing hash index over the links, only used when index
+	// is not null; frontOrder and backOrder bound every entry's order
+	struct IndexEntry* index;
+	int indexCapacity;
+	int indexCount;
+	long frontOrder;
+	long backOrder;
+
+#ifdef CS261_STATS
+	struct LinkedListStats stats;
+#endif
 };
 
 
@@ -65,8 +121,348 @@ static void init(struct LinkedList* list) {
     // and back's next pointing to null 
     list->frontSentinel->next = list->backSentinel;
     list->backSentinel->prev = list->frontSentinel;
+    list->frontSentinel->prev = 0;
+    list->backSentinel->next = 0;
     list->size = 0;
     
+    // lists start out using malloc for every link
+    list->pooled = 0;
+    list->pages = 0;
+    list->freeLinks = 0;
+    list->freeCount = 0;
+    
+    // lists start out without a hash index
+    list->index = 0;
+    list->indexCapacity = 0;
+    list->indexCount = 0;
+    list->frontOrder = 0;
+    list->backOrder = 0;
+    
+    linkedListStatsReset(list);
+}
+
+
+
+/*********************************************************************
+** Function: addLinkPage
+**
+** Description: allocates a page of count links and pushes every link
+**              in it onto the list's free links
+**
+** Parameters: a list and the number of links in the page
+**
+** Pre-Conditions:  list has been initialized and is pooled
+** Post-Conditions: a new page is at the head of the list's pages and
+**                  its links are available to allocLink
+*********************************************************************/
+static void addLinkPage(struct LinkedList* list, int count)
+{
+    assert(list!=0 && count>0);
+    
+    // one malloc for the page header and all of its links
+    struct LinkPage* page = malloc(sizeof(struct LinkPage) +
+                                   count * sizeof(struct Link));
+    assert(page!=0);
+    STAT_ADD(list, allocations, 1);
+    page->count = count;
+    page->next = list->pages;
+    list->pages = page;
+    
+    // thread the links onto the free list, first link on top
+    for(int i = count - 1; i >= 0; i--){
+        page->links[i].next = list->freeLinks;
+        list->freeLinks = &page->links[i];
+    }
+    list->freeCount += count;
+}
+
+
+
+/*********************************************************************
+** Function: allocLink
+**
+** Description: returns an unlinked link, either from the list's free
+**              links or from malloc when the list is not pooled
+**
+** Parameters: a list
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: the returned link is owned by the caller
+*********************************************************************/
+static struct Link* allocLink(struct LinkedList* list)
+{
+    if(!list->pooled){
+        struct Link* link = malloc(sizeof(struct Link));
+        assert(link!=0);
+        STAT_ADD(list, allocations, 1);
+        return link;
+    }
+    
+    // refill from a fresh page only when every recycled link is in use
+    if(list->freeLinks == 0){
+        addLinkPage(list, LINK_PAGE_SIZE);
+    }
+    struct Link* link = list->freeLinks;
+    list->freeLinks = link->next;
+    list->freeCount--;
+    return link;
+}
+
+
+
+/*********************************************************************
+** Function: freeLink
+**
+** Description: gives a link back to the list's free links, or to libc
+**              when the list is not pooled
+**
+** Parameters: a list and link
+**
+** Pre-Conditions:  link came from allocLink on the same list and is no
+**                  longer linked in
+** Post-Conditions: the link may be handed out again by allocLink
+*********************************************************************/
+static void freeLink(struct LinkedList* list, struct Link* link)
+{
+    if(!list->pooled){
+        free(link);
+        STAT_ADD(list, frees, 1);
+        return;
+    }
+    link->next = list->freeLinks;
+    list->freeLinks = link;
+    list->freeCount++;
+}
+
+
+
+/*********************************************************************
+** Function: reserveLinks
+**
+** Description: makes sure a pooled list can hand out count links
+**              without allocating, using a single page for the shortfall
+**
+** Parameters: a list and the number of links needed
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: the next count calls to allocLink on a pooled list
+**                  will not allocate
+*********************************************************************/
+static void reserveLinks(struct LinkedList* list, int count)
+{
+    if(!list->pooled || list->freeCount >= count) return;
+    
+    int shortfall = count - list->freeCount;
+    addLinkPage(list, shortfall > LINK_PAGE_SIZE ? shortfall : LINK_PAGE_SIZE);
+}
+
+
+
+/*********************************************************************
+** Function: homeSlot
+**
+** Description: returns the index slot a value's probe run starts at,
+**              folding the high bits of HASH into the low ones first
+**
+** Parameters: a list and value
+**
+** Pre-Conditions:  list has an index
+** Post-Conditions: NONE
+*********************************************************************/
+static unsigned int homeSlot(struct LinkedList* list, TYPE value)
+{
+    unsigned int hash = HASH(value);
+    return (hash ^ (hash >> 16)) & (list->indexCapacity - 1);
+}
+
+
+
+/*********************************************************************
+** Function: indexInsert
+**
+** Description: records a link and its order in the list's hash index,
+**              doubling the index first when it is half full
+**
+** Parameters: a list, link and order
+**
+** Pre-Conditions:  list has an index, link is not in it yet
+** Post-Conditions: the link can be found by its value
+*********************************************************************/
+static void indexInsert(struct LinkedList* list, struct Link* link, long order)
+{
+    if(2 * (list->indexCount + 1) > list->indexCapacity){
+        struct IndexEntry* old = list->index;
+        int oldCapacity = list->indexCapacity;
+        
+        list->indexCapacity = oldCapacity * 2;
+        list->index = calloc(list->indexCapacity, sizeof(struct IndexEntry));
+        assert(list->index!=0);
+        STAT_ADD(list, allocations, 1);
+        list->indexCount = 0;
+        for(int i = 0; i < oldCapacity; i++){
+            if(old[i].link!=0) indexInsert(list, old[i].link, old[i].order);
+        }
+        free(old);
+        STAT_ADD(list, frees, 1);
+    }
+    
+    // linear probing from the value's home slot
+    unsigned int mask = list->indexCapacity - 1;
+    unsigned int i = homeSlot(list, link->value);
+    while(list->index[i].link!=0){
+        i = (i + 1) & mask;
+    }
+    list->index[i].link = link;
+    list->index[i].order = order;
+    list->indexCount++;
+}
+
+
+
+/*********************************************************************
+** Function: indexErase
+**
+** Description: removes a link from the list's hash index, shifting the
+**              rest of its probe run back so no tombstones are needed
+**
+** Parameters: a list and link
+**
+** Pre-Conditions:  list has an index that holds the link
+** Post-Conditions: the link is no longer in the index
+*********************************************************************/
+static void indexErase(struct LinkedList* list, struct Link* link)
+{
+    unsigned int mask = list->indexCapacity - 1;
+    unsigned int hole = homeSlot(list, link->value);
+    while(list->index[hole].link != link){
+        assert(list->index[hole].link!=0);
+        hole = (hole + 1) & mask;
+    }
+    
+    // pull back every later entry of the run that may sit in the hole
+    unsigned int next = hole;
+    for(;;){
+        next = (next + 1) & mask;
+        if(list->index[next].link == 0) break;
+        
+        unsigned int home = homeSlot(list, list->index[next].link->value);
+        int stays = hole <= next ? (hole < home && home <= next)
+                                 : (hole < home || home <= next);
+        if(!stays){
+            list->index[hole] = list->index[next];
+            hole = next;
+        }
+    }
+    list->index[hole].link = 0;
+    list->indexCount--;
+}
+
+
+
+/*********************************************************************
+** Function: indexRenumber
+**
+** Description: rebuilds the list's hash index, giving each link an order
+**              that matches its position from front to back
+**
+** Parameters: a list
+**
+** Pre-Conditions:  list has an index
+** Post-Conditions: every link is in the index in list order
+*********************************************************************/
+static void indexRenumber(struct LinkedList* list)
+{
+    for(int i = 0; i < list->indexCapacity; i++){
+        list->index[i].link = 0;
+    }
+    list->indexCount = 0;
+    list->frontOrder = 0;
+    list->backOrder = 0;
+    
+    struct Link* temp = list->frontSentinel->next;
+    while(temp != list->backSentinel){
+        indexInsert(list, temp, list->backOrder++);
+        temp = temp->next;
+    }
+}
+
+
+
+/*********************************************************************
+** Function: indexLinks
+**
+** Description: adds a run of newly linked links to the list's hash
+**              index when it has one
+**
+** Parameters: a list, the first and the last link of the run
+**
+** Pre-Conditions:  the run is linked into the list
+** Post-Conditions: every link of the run is in the index
+*********************************************************************/
+static void indexLinks(struct LinkedList* list, struct Link* first, struct Link* last)
+{
+    if(list->index == 0) return;
+    
+    if(last->next == list->backSentinel){
+        // appended, orders keep growing toward the back
+        for(struct Link* temp = first; ; temp = temp->next){
+            indexInsert(list, temp, list->backOrder++);
+            if(temp == last) break;
+        }
+    }
+    else if(first->prev == list->frontSentinel){
+        // prepended, orders keep shrinking toward the front
+        for(struct Link* temp = last; ; temp = temp->prev){
+            indexInsert(list, temp, --list->frontOrder);
+            if(temp == first) break;
+        }
+    }
+    else {
+        indexRenumber(list);
+    }
+}
+
+
+
+/*********************************************************************
+** Function: addLinksBefore
+**
+** Description: adds count new links holding values, in array order,
+**              before the given link and grows the list's size once
+**
+** Parameters: a List, Link, array of values and number of values
+**
+** Pre-Conditions:  both the list and the link have space allocated for
+**                  them, values holds at least count values
+** Post-Conditions: the new links sit, in order, between the link's old
+**                  previous link and the link
+*********************************************************************/
+static void addLinksBefore(struct LinkedList* list, struct Link* link,
+                           const TYPE* values, int count)
+{
+    assert(list && link);
+    assert(count>=0 && (values!=0 || count==0));
+    
+    reserveLinks(list, count);
+    
+    // chain the new links off the old previous link
+    struct Link* before = link->prev;
+    struct Link* last = before;
+    for(int i = 0; i < count; i++){
+        struct Link* new = allocLink(list);
+        new->value = values[i];
+        new->prev = last;
+        last->next = new;
+        last = new;
+    }
+    
+    // close the chain onto the passed link
+    last->next = link;
+    link->prev = last;
+    list->size += count;
+    STAT_PEAK(list);
+    
+    if(count > 0) indexLinks(list, before->next, last);
 }
 
 
@@ -90,9 +486,8 @@ static void addLinkBefore(struct LinkedList* list, struct Link* link, TYPE value
     // assert list and link are not null
     assert(list && link);
     
-    // malloc room for new link
-    struct Link* new = malloc(sizeof(struct Link));
-    assert(new!=0);
+    // get room for new link
+    struct Link* new = allocLink(list);
     // assign value to new link
     new->value = value;
     
@@ -108,6 +503,9 @@ static void addLinkBefore(struct LinkedList* list, struct Link* link, TYPE value
     
     // incremenet size
     list->size++;
+    STAT_PEAK(list);
+    
+    indexLinks(list, new, new);
 }
 
 
@@ -130,17 +528,19 @@ static void removeLink(struct LinkedList* list, struct Link* link)
     // assert list and link are not null
     assert(list && link);
     
+    if(list->index!=0) indexErase(list, link);
+    
     // store links previous and next
     struct Link*tempPrev = link->prev;
     struct Link*tempNext = link->next;
     
-    // free the link
-    free(link);
-    
     // set stored links to point to each other
     tempPrev->next = tempNext;
     tempNext->prev = tempPrev;
     
+    // free the link
+    freeLink(list, link);
+    
     //decrement the list size
     list->size--;
 }
@@ -170,11 +570,35 @@ struct LinkedList* linkedListCreate()
 
 
 
+/*********************************************************************
+** Function: linkedListCreatePooled
+**
+** Description: allocates and initializes a list whose links are carved
+**              out of contiguous pages and recycled on removal instead
+**              of going back to malloc and free
+**
+** Parameters: none
+**
+** Pre-Conditions:  none
+** Post-Conditions: a new, empty pooled list is returned; its pages are
+**                  only released by linkedListDestroy
+*********************************************************************/
+struct LinkedList* linkedListCreatePooled()
+{
+	struct LinkedList* newDeque = linkedListCreate();
+	newDeque->pooled = 1;
+	return newDeque;
+}
+
+
+
+
 /*********************************************************************
 ** Function: linkedListDestroy
 **
 ** Description: deallocates every link in the list including the sentinels
-**               and frees the list itself
+**               and frees the list itself, a pooled list releases its
+**               pages all at once
 **
 ** Parameters: a list
 **
@@ -185,6 +609,16 @@ struct LinkedList* linkedListCreate()
 void linkedListDestroy(struct LinkedList* list)
 {
     assert(list!=0);
+    linkedListDisableIndex(list);
+    if(list->pooled){
+        // every link lives in a page, so no need to unlink them one by one
+        while(list->pages!=0){
+            struct LinkPage* page = list->pages;
+            list->pages = page->next;
+            free(page);
+        }
+        list->size = 0;
+    }
 	while (!linkedListIsEmpty(list))
 	{
 		linkedListRemoveFront(list);
@@ -321,6 +755,142 @@ void linkedListRemoveBack(struct LinkedList* list)
 
 
 
+/*********************************************************************
+** Function: linkedListAddFrontArray
+**
+** Description: adds count values to the front of the list, keeping
+**              their array order, so values[0] becomes the front
+**
+** Parameters: a list, array of values and number of values
+**
+** Pre-Conditions:  list has been initialized, values holds count values
+** Post-Conditions: the values are at the front of the list
+*********************************************************************/
+void linkedListAddFrontArray(struct LinkedList* list, const TYPE* values, int count)
+{
+    assert(list!=0);
+    addLinksBefore(list, list->frontSentinel->next, values, count);
+}
+
+
+
+
+/*********************************************************************
+** Function: linkedListAddBackArray
+**
+** Description: adds count values to the back of the list in array
+**              order, so values[count-1] becomes the back
+**
+** Parameters: a list, array of values and number of values
+**
+** Pre-Conditions:  list has been initialized, values holds count values
+** Post-Conditions: the values are at the back of the list
+*********************************************************************/
+void linkedListAddBackArray(struct LinkedList* list, const TYPE* values, int count)
+{
+    assert(list!=0);
+    addLinksBefore(list, list->backSentinel, values, count);
+}
+
+
+
+
+/*********************************************************************
+** Function: linkedListRemoveFrontArray
+**
+** Description: removes up to count links from the front of the list,
+**              copying their values front to back into out
+**
+** Parameters: a list, output array and maximum number to remove
+**
+** Pre-Conditions:  list has been initialized, out has room for count
+**                  values
+** Post-Conditions: returns how many values were removed
+*********************************************************************/
+int linkedListRemoveFrontArray(struct LinkedList* list, TYPE* out, int count)
+{
+    assert(list!=0 && count>=0);
+    if(count > list->size) count = list->size;
+    
+    struct Link* temp = list->frontSentinel->next;
+    for(int i = 0; i < count; i++){
+        struct Link* next = temp->next;
+        out[i] = temp->value;
+        if(list->index!=0) indexErase(list, temp);
+        freeLink(list, temp);
+        temp = next;
+    }
+    
+    // relink the sentinel to the first link that is left
+    list->frontSentinel->next = temp;
+    temp->prev = list->frontSentinel;
+    list->size -= count;
+    return count;
+}
+
+
+
+
+/*********************************************************************
+** Function: linkedListRemoveBackArray
+**
+** Description: removes up to count links from the back of the list,
+**              copying their values into out in the order they are
+**              removed, back first
+**
+** Parameters: a list, output array and maximum number to remove
+**
+** Pre-Conditions:  list has been initialized, out has room for count
+**                  values
+** Post-Conditions: returns how many values were removed
+*********************************************************************/
+int linkedListRemoveBackArray(struct LinkedList* list, TYPE* out, int count)
+{
+    assert(list!=0 && count>=0);
+    if(count > list->size) count = list->size;
+    
+    struct Link* temp = list->backSentinel->prev;
+    for(int i = 0; i < count; i++){
+        struct Link* prev = temp->prev;
+        out[i] = temp->value;
+        if(list->index!=0) indexErase(list, temp);
+        freeLink(list, temp);
+        temp = prev;
+    }
+    
+    // relink the sentinel to the last link that is left
+    list->backSentinel->prev = temp;
+    temp->next = list->backSentinel;
+    list->size -= count;
+    return count;
+}
+
+
+
+
+/*********************************************************************
+** Function: linkedListDrain
+**
+** Description: removes every link, copying the values front to back
+**              into out
+**
+** Parameters: a list and output array
+**
+** Pre-Conditions:  list has been initialized, out has room for every
+**                  value in the list
+** Post-Conditions: the list is empty, returns how many values were
+**                  removed
+*********************************************************************/
+int linkedListDrain(struct LinkedList* list, TYPE* out)
+{
+    assert(list!=0);
+    return linkedListRemoveFrontArray(list, out, list->size);
+}
+
+
+
+
+
 /*********************************************************************
 ** Function: linkedListIsEmpty
 **
@@ -394,7 +964,8 @@ void linkedListAdd(struct LinkedList* list, TYPE value)
 /*********************************************************************
 ** Function: linkedListContains
 **
-** Description: searchs the list for a value
+** Description: searchs the list for a value, through the hash index
+**              when the list has one
 **
 ** Parameters: a list and value
 **
@@ -404,8 +975,18 @@ void linkedListAdd(struct LinkedList* list, TYPE value)
 int linkedListContains(struct LinkedList* list, TYPE value)
 {
     assert(list!=0);
+    if(list->index!=0){
+        unsigned int mask = list->indexCapacity - 1;
+        for(unsigned int i = homeSlot(list, value); list->index[i].link!=0; i = (i + 1) & mask){
+            STAT_ADD(list, traversed, 1);
+            if(EQ(value, list->index[i].link->value)) return 1;
+        }
+        return 0;
+    }
+    
     struct Link* temp = list->frontSentinel->next;
     while(temp!= list->backSentinel){
+        STAT_ADD(list, traversed, 1);
         if(EQ(value, temp->value)) return 1;
         temp = temp->next;
     }
@@ -417,7 +998,8 @@ int linkedListContains(struct LinkedList* list, TYPE value)
 /*********************************************************************
 ** Function: linkedListREMOVE
 **
-** Description: removes first instance of a link with the value passed
+** Description: removes first instance of a link with the value passed,
+**              through the hash index when the list has one
 **
 ** Parameters: a list and value
 **
@@ -428,13 +1010,650 @@ int linkedListContains(struct LinkedList* list, TYPE value)
 void linkedListRemove(struct LinkedList* list, TYPE value)
 {
     assert(list!=0);
+    if(list->index!=0){
+        // equal values share a probe run, the lowest order is first
+        struct IndexEntry* first = 0;
+        unsigned int mask = list->indexCapacity - 1;
+        for(unsigned int i = homeSlot(list, value); list->index[i].link!=0; i = (i + 1) & mask){
+            struct IndexEntry* entry = &list->index[i];
+            STAT_ADD(list, traversed, 1);
+            if(EQ(value, entry->link->value) && (first == 0 || entry->order < first->order)){
+                first = entry;
+            }
+        }
+        if(first!=0) removeLink(list, first->link);
+        return;
+    }
+    
     struct Link* temp = list->frontSentinel->next;
 
     while(temp!= list->backSentinel){
-        if(temp->value == value){
+        STAT_ADD(list, traversed, 1);
+        if(EQ(value, temp->value)){
             removeLink(list, temp);
             break;
         }
         temp = temp->next;
     }
 }
+
+/*********************************************************************
+** Function: linkedListEnableIndex
+**
+** Description: builds a hash index mapping values to links, after which
+**              linkedListContains and linkedListRemove run in O(1)
+**              expected time; the list keeps its order and deque
+**              behavior, each add and remove also updates the index
+**
+** Parameters: a list
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: the list has an index holding every link
+*********************************************************************/
+void linkedListEnableIndex(struct LinkedList* list)
+{
+    assert(list!=0);
+    if(list->index!=0) return;
+    
+    // keep the index at most half full
+    list->indexCapacity = 16;
+    while(list->indexCapacity < 2 * list->size){
+        list->indexCapacity *= 2;
+    }
+    list->index = calloc(list->indexCapacity, sizeof(struct IndexEntry));
+    assert(list->index!=0);
+    STAT_ADD(list, allocations, 1);
+    indexRenumber(list);
+}
+
+/*********************************************************************
+** Function: linkedListDisableIndex
+**
+** Description: frees the list's hash index, lookups go back to walking
+**              the links
+**
+** Parameters: a list
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: the list has no index
+*********************************************************************/
+void linkedListDisableIndex(struct LinkedList* list)
+{
+    assert(list!=0);
+    if(list->index!=0) STAT_ADD(list, frees, 1);
+    free(list->index);
+    list->index = 0;
+    list->indexCapacity = 0;
+    list->indexCount = 0;
+}
+
+/*********************************************************************
+** Function: linkedListCursorBegin
+**
+** Description: puts a cursor on the front value
+**
+** Parameters: a list and cursor
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: the cursor is valid unless the list is empty
+*********************************************************************/
+void linkedListCursorBegin(struct LinkedList* list, struct LinkedListCursor* cursor)
+{
+    assert(list!=0 && cursor!=0);
+    cursor->list = list;
+    cursor->link = list->frontSentinel->next;
+}
+
+/*********************************************************************
+** Function: linkedListCursorLast
+**
+** Description: puts a cursor on the back value, for walking the list
+**              back to front with linkedListCursorPrev
+**
+** Parameters: a list and cursor
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: the cursor is valid unless the list is empty
+*********************************************************************/
+void linkedListCursorLast(struct LinkedList* list, struct LinkedListCursor* cursor)
+{
+    assert(list!=0 && cursor!=0);
+    cursor->list = list;
+    cursor->link = list->backSentinel->prev;
+}
+
+/*********************************************************************
+** Function: linkedListCursorValid
+**
+** Description: returns 1 if the cursor is on a value and 0 once it
+**              has moved past either end
+**
+** Parameters: a cursor
+**
+** Pre-Conditions:  the cursor has been placed by Begin or Last
+** Post-Conditions: NONE
+*********************************************************************/
+int linkedListCursorValid(struct LinkedListCursor* cursor)
+{
+    assert(cursor!=0);
+    return cursor->link!=cursor->list->frontSentinel && cursor->link!=cursor->list->backSentinel;
+}
+
+/*********************************************************************
+** Function: linkedListCursorNext
+**
+** Description: moves the cursor one value toward the back, fetching
+**              the link after that into cache while the caller works
+**              on this one
+**
+** Parameters: a cursor
+**
+** Pre-Conditions:  the cursor is valid
+** Post-Conditions: the cursor is on the next value or past the back
+*********************************************************************/
+void linkedListCursorNext(struct LinkedListCursor* cursor)
+{
+    assert(linkedListCursorValid(cursor));
+    cursor->link = cursor->link->next;
+    PREFETCH(cursor->link->next);
+}
+
+/*********************************************************************
+** Function: linkedListCursorPrev
+**
+** Description: moves the cursor one value toward the front
+**
+** Parameters: a cursor
+**
+** Pre-Conditions:  the cursor is valid
+** Post-Conditions: the cursor is on the previous value or past the
+**                  front
+*********************************************************************/
+void linkedListCursorPrev(struct LinkedListCursor* cursor)
+{
+    assert(linkedListCursorValid(cursor));
+    cursor->link = cursor->link->prev;
+    PREFETCH(cursor->link->prev);
+}
+
+/*********************************************************************
+** Function: linkedListCursorGet
+**
+** Description: returns the value under the cursor
+**
+** Parameters: a cursor
+**
+** Pre-Conditions:  the cursor is valid
+** Post-Conditions: NONE
+*********************************************************************/
+TYPE linkedListCursorGet(struct LinkedListCursor* cursor)
+{
+    assert(linkedListCursorValid(cursor));
+    return cursor->link->value;
+}
+
+/*********************************************************************
+** Function: linkedListCursorRemove
+**
+** Description: removes the value under the cursor in O(1) and moves
+**              the cursor on to the value that followed it
+**
+** Parameters: a cursor
+**
+** Pre-Conditions:  the cursor is valid
+** Post-Conditions: the value is gone, the cursor is on the next value
+**                  or past the back
+*********************************************************************/
+void linkedListCursorRemove(struct LinkedListCursor* cursor)
+{
+    assert(linkedListCursorValid(cursor));
+    struct Link* next = cursor->link->next;
+    removeLink(cursor->list, cursor->link);
+    cursor->link = next;
+}
+
+/*********************************************************************
+** Function: linkedListForEach
+**
+** Description: calls visit on every value front to back until visit
+**              returns 0, prefetching two links ahead of the visit
+**
+** Parameters: a list, the visitor and an argument passed to it
+**
+** Pre-Conditions:  list has been initialized, visit does not change
+**                  the list
+** Post-Conditions: returns how many values were visited
+*********************************************************************/
+int linkedListForEach(struct LinkedList* list, int (*visit)(TYPE value, void* arg), void* arg)
+{
+    assert(list!=0 && visit!=0);
+    int visited = 0;
+    struct Link* temp = list->frontSentinel->next;
+    while(temp!=list->backSentinel){
+        struct Link* next = temp->next;
+        // the back sentinel's next is null, the prefetch is only a hint
+        PREFETCH(next->next);
+        visited++;
+        if(!visit(temp->value, arg)) break;
+        temp = next;
+    }
+    STAT_ADD(list, traversed, visited);
+    return visited;
+}
+
+/*********************************************************************
+** Function: linkedListRemoveIf
+**
+** Description: removes every value match returns nonzero for, in one
+**              pass over the list
+**
+** Parameters: a list, the predicate and an argument passed to it
+**
+** Pre-Conditions:  list has been initialized, match does not change
+**                  the list
+** Post-Conditions: returns how many values were removed
+*********************************************************************/
+int linkedListRemoveIf(struct LinkedList* list, int (*match)(TYPE value, void* arg), void* arg)
+{
+    assert(list!=0 && match!=0);
+    int removed = 0;
+    struct LinkedListCursor cursor;
+    for(linkedListCursorBegin(list, &cursor); linkedListCursorValid(&cursor); ){
+        if(match(cursor.link->value, arg)){
+            linkedListCursorRemove(&cursor);
+            removed++;
+        }
+        else linkedListCursorNext(&cursor);
+    }
+    STAT_ADD(list, traversed, list->size + removed);
+    return removed;
+}
+
+/*********************************************************************
+** Function: moveLinks
+**
+** Description: moves the run of count links from first to last out of
+**              one list and in front of a link of another. Lists that
+**              malloc their links just relink the run; a pooled list
+**              keeps its links in its own pages, so to or from one
+**              the values are copied and the links freed instead
+**
+** Parameters: the list the run is in, its first and last link and
+**             length, the list to move it to and the link to put it
+**             before, which may be that list's back sentinel
+**
+** Pre-Conditions:  the lists are different, first through last is a
+**                  run of from's links
+** Post-Conditions: the run sits in front of before, in order
+*********************************************************************/
+static void moveLinks(struct LinkedList* from, struct Link* first, struct Link* last, int count,
+                      struct LinkedList* to, struct Link* before)
+{
+    assert(from!=to);
+    if(count == 0) return;
+    
+    if(from->pooled || to->pooled){
+        TYPE values[LINK_PAGE_SIZE];
+        struct Link* end = last->next;
+        while(first != end){
+            int n = 0;
+            while(first != end && n < LINK_PAGE_SIZE){
+                struct Link* next = first->next;
+                values[n++] = first->value;
+                removeLink(from, first);
+                first = next;
+            }
+            addLinksBefore(to, before, values, n);
+        }
+        return;
+    }
+    
+    if(from->index!=0){
+        for(struct Link* temp = first; ; temp = temp->next){
+            indexErase(from, temp);
+            if(temp == last) break;
+        }
+    }
+    
+    // close the gap the run leaves
+    first->prev->next = last->next;
+    last->next->prev = first->prev;
+    from->size -= count;
+    
+    // and open one for it in front of before
+    first->prev = before->prev;
+    last->next = before;
+    before->prev->next = first;
+    before->prev = last;
+    to->size += count;
+    STAT_PEAK(to);
+    
+    indexLinks(to, first, last);
+}
+
+/*********************************************************************
+** Function: linkedListConcat
+**
+** Description: moves every value of other onto the back of list in
+**              O(1), leaving other empty
+**
+** Parameters: two lists
+**
+** Pre-Conditions:  the lists are different; if either is pooled or
+**                  indexed the values are copied or indexed one by one
+** Post-Conditions: other is empty
+*********************************************************************/
+void linkedListConcat(struct LinkedList* list, struct LinkedList* other)
+{
+    assert(list!=0 && other!=0 && list!=other);
+    moveLinks(other, other->frontSentinel->next, other->backSentinel->prev, other->size,
+              list, list->backSentinel);
+}
+
+/*********************************************************************
+** Function: linkedListSplice
+**
+** Description: moves the values from first through last, both
+**              included, in front of position in another list. The
+**              links are relinked in O(1), but counting the run to
+**              keep both sizes walks it
+**
+** Parameters: a cursor on the value to insert before, or past the
+**             back to append, and cursors on the first and last value
+**             to move
+**
+** Pre-Conditions:  first and last are valid cursors of one list, last
+**                  is not before first, position is on another list
+** Post-Conditions: position is still on the same value; first and
+**                  last are not valid any more
+*********************************************************************/
+void linkedListSplice(struct LinkedListCursor* position, struct LinkedListCursor* first,
+                      struct LinkedListCursor* last)
+{
+    assert(position!=0 && position->link!=position->list->frontSentinel);
+    assert(linkedListCursorValid(first) && linkedListCursorValid(last));
+    assert(first->list==last->list && first->list!=position->list);
+    
+    int count = 1;
+    for(struct Link* temp = first->link; temp != last->link; temp = temp->next){
+        assert(temp!=first->list->backSentinel);
+        count++;
+    }
+    STAT_ADD(first->list, traversed, count);
+    moveLinks(first->list, first->link, last->link, count, position->list, position->link);
+}
+
+/*********************************************************************
+** Function: linkedListSplit
+**
+** Description: moves the value under the cursor and every value after
+**              it onto the back of other. Counting the values that
+**              move walks both ways from the cursor at once, so it
+**              costs the shorter of the two parts
+**
+** Parameters: a cursor and the list to move the values to
+**
+** Pre-Conditions:  the cursor is valid, other is another list
+** Post-Conditions: the cursor's list ends just before where the cursor
+**                  was, the cursor is past its back
+*********************************************************************/
+void linkedListSplit(struct LinkedListCursor* cursor, struct LinkedList* other)
+{
+    assert(linkedListCursorValid(cursor));
+    struct LinkedList* list = cursor->list;
+    assert(other!=0 && other!=list);
+    
+    struct Link* forward = cursor->link;
+    struct Link* backward = cursor->link->prev;
+    int moved = 0, kept = 0;
+    for(;;){
+        if(forward == list->backSentinel){
+            kept = list->size - moved;
+            break;
+        }
+        if(backward == list->frontSentinel){
+            moved = list->size - kept;
+            break;
+        }
+        moved++;
+        kept++;
+        forward = forward->next;
+        backward = backward->prev;
+    }
+    STAT_ADD(list, traversed, 2 * (moved < kept ? moved : kept));
+    
+    moveLinks(list, cursor->link, list->backSentinel->prev, moved, other, other->backSentinel);
+    cursor->link = list->backSentinel;
+}
+
+/*********************************************************************
+** Function: mergeChains
+**
+** Description: merges two sorted chains linked through next and ended
+**              by null, taking from the first on ties so the merge is
+**              stable
+**
+** Parameters: the earlier and the later chain
+**
+** Pre-Conditions:  both chains are sorted by LT
+** Post-Conditions: returns the head of the merged chain, prev pointers
+**                  are left for the caller to fix
+*********************************************************************/
+static struct Link* mergeChains(struct Link* first, struct Link* second)
+{
+    struct Link head;
+    struct Link* tail = &head;
+    while(first!=0 && second!=0){
+        if(LT(second->value, first->value)){
+            tail->next = second;
+            second = second->next;
+        }
+        else {
+            tail->next = first;
+            first = first->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = first!=0 ? first : second;
+    return head.next;
+}
+
+/*********************************************************************
+** Function: linkedListSort
+**
+** Description: sorts the list by LT with a stable bottom-up merge
+**              sort that only relinks, in O(n log n) with no
+**              allocation. bins[i] holds a sorted run of 2^i links,
+**              and every link carries into the bins like a binary
+**              counter
+**
+** Parameters: a list
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: the list is in order, equal values in the order
+**                  they were in before
+*********************************************************************/
+void linkedListSort(struct LinkedList* list)
+{
+    assert(list!=0);
+    if(list->size < 2) return;
+    
+    struct Link* bins[64] = {0};
+    int used = 0;
+    struct Link* temp = list->frontSentinel->next;
+    while(temp != list->backSentinel){
+        struct Link* carry = temp;
+        temp = temp->next;
+        carry->next = 0;
+        
+        // the bins hold earlier links, so they go first
+        int i = 0;
+        for(; bins[i]!=0; i++){
+            carry = mergeChains(bins[i], carry);
+            bins[i] = 0;
+        }
+        bins[i] = carry;
+        if(i >= used) used = i + 1;
+    }
+    
+    // higher bins hold earlier links too
+    struct Link* sorted = 0;
+    for(int i = 0; i < used; i++){
+        if(bins[i]!=0) sorted = mergeChains(bins[i], sorted);
+    }
+    STAT_ADD(list, traversed, list->size);
+    
+    // put the prev pointers and the sentinels back
+    struct Link* last = list->frontSentinel;
+    for(temp = sorted; temp!=0; temp = temp->next){
+        last->next = temp;
+        temp->prev = last;
+        last = temp;
+    }
+    last->next = list->backSentinel;
+    list->backSentinel->prev = last;
+    
+    if(list->index!=0) indexRenumber(list);
+}
+
+/*********************************************************************
+** Function: linkedListAddSorted
+**
+** Description: adds a value after every value not greater than it,
+**              searching from the back so values that mostly arrive
+**              in order are added in O(1)
+**
+** Parameters: a list and value
+**
+** Pre-Conditions:  the list is sorted by LT
+** Post-Conditions: the list is still sorted
+*********************************************************************/
+void linkedListAddSorted(struct LinkedList* list, TYPE value)
+{
+    assert(list!=0);
+    struct Link* temp = list->backSentinel;
+    while(temp->prev != list->frontSentinel && LT(value, temp->prev->value)){
+        temp = temp->prev;
+        STAT_ADD(list, traversed, 1);
+    }
+    addLinkBefore(list, temp, value);
+}
+
+/*********************************************************************
+** Function: linkedListMerge
+**
+** Description: merges every value of other into list in O(n+m),
+**              leaving other empty. The links are relinked, or for a
+**              pooled list copied and recycled as with
+**              linkedListConcat, and any index is rebuilt once at
+**              the end
+**
+** Parameters: two lists
+**
+** Pre-Conditions:  the lists are different and both sorted by LT
+** Post-Conditions: list is sorted, values equal to one of list's
+**                  come after it, other is empty
+*********************************************************************/
+void linkedListMerge(struct LinkedList* list, struct LinkedList* other)
+{
+    assert(list!=0 && other!=0 && list!=other);
+    int relink = !list->pooled && !other->pooled;
+    
+    struct Link* at = list->frontSentinel->next;
+    struct Link* temp = other->frontSentinel->next;
+    while(temp != other->backSentinel){
+        struct Link* next = temp->next;
+        while(at != list->backSentinel && !LT(temp->value, at->value)){
+            at = at->next;
+        }
+        
+        struct Link* link = temp;
+        if(!relink){
+            link = allocLink(list);
+            link->value = temp->value;
+            freeLink(other, temp);
+        }
+        link->prev = at->prev;
+        link->next = at;
+        at->prev->next = link;
+        at->prev = link;
+        temp = next;
+    }
+    STAT_ADD(list, traversed, list->size + other->size);
+    
+    list->size += other->size;
+    STAT_PEAK(list);
+    other->size = 0;
+    other->frontSentinel->next = other->backSentinel;
+    other->backSentinel->prev = other->frontSentinel;
+    
+    if(list->index!=0) indexRenumber(list);
+    if(other->index!=0) indexRenumber(other);
+}
+
+/*********************************************************************
+** Function: linkedListStats
+**
+** Description: copies the list's instrumentation counters; every
+**              counter reads 0 unless the list was built with
+**              CS261_STATS defined
+**
+** Parameters: a list and where to copy the counters
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: stats holds the counters since the last reset
+*********************************************************************/
+void linkedListStats(struct LinkedList* list, struct LinkedListStats* stats)
+{
+    assert(list!=0 && stats!=0);
+#ifdef CS261_STATS
+    *stats = list->stats;
+#else
+    stats->allocations = 0;
+    stats->frees = 0;
+    stats->traversed = 0;
+    stats->peakSize = 0;
+#endif
+}
+
+/*********************************************************************
+** Function: linkedListStatsReset
+**
+** Description: zeroes the list's instrumentation counters, the peak
+**              size starts over from the current size
+**
+** Parameters: a list
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: the counters read 0
+*********************************************************************/
+void linkedListStatsReset(struct LinkedList* list)
+{
+    assert(list!=0);
+#ifdef CS261_STATS
+    list->stats.allocations = 0;
+    list->stats.frees = 0;
+    list->stats.traversed = 0;
+    list->stats.peakSize = list->size;
+#endif
+}
+
+/*********************************************************************
+** Function: linkedListStatsPrint
+**
+** Description: prints the list's instrumentation counters as one line
+**              of JSON
+**
+** Parameters: a list
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: the counters have been printf'd
+*********************************************************************/
+void linkedListStatsPrint(struct LinkedList* list)
+{
+    struct LinkedListStats stats;
+    linkedListStats(list, &stats);
+    printf("{\"structure\": \"LinkedList\", \"allocations\": %lu, \"frees\": %lu, "
+           "\"traversed\": %lu, \"peak_size\": %d}\n",
+           stats.allocations, stats.frees, stats.traversed, stats.peakSize);
+}
@@ -13,9 +13,34 @@
 #define EQ(A, B) ((A) == (B))
 #endif
 
+#ifndef HASH
+#define HASH(A) ((unsigned int)(A) * 2654435761u)
+#endif
+
 struct LinkedList;
+struct Link;
+
+// Position in a list for walking it in either direction. A cursor
+// moved past either end is no longer valid, and removing values any
+// other way than through the cursor may leave it pointing at freed
+// memory.
+struct LinkedListCursor
+{
+	struct LinkedList* list;
+	struct Link* link;
+};
+
+// Instrumentation counters, only kept when built with CS261_STATS
+struct LinkedListStats
+{
+	unsigned long allocations;	// mallocs of links, pages and index tables
+	unsigned long frees;
+	unsigned long traversed;	// links and index slots looked at by searches
+	int peakSize;
+};
 
 struct LinkedList* linkedListCreate();
+struct LinkedList* linkedListCreatePooled();
 void linkedListDestroy(struct LinkedList* list);
 void linkedListPrint(struct LinkedList* list);
 
@@ -29,10 +54,53 @@ TYPE linkedListBack(struct LinkedList* list);
 void linkedListRemoveFront(struct LinkedList* list);
 void linkedListRemoveBack(struct LinkedList* list);
 
+// Bulk interface
+
+void linkedListAddFrontArray(struct LinkedList* list, const TYPE* values, int count);
+void linkedListAddBackArray(struct LinkedList* list, const TYPE* values, int count);
+int linkedListRemoveFrontArray(struct LinkedList* list, TYPE* out, int count);
+int linkedListRemoveBackArray(struct LinkedList* list, TYPE* out, int count);
+int linkedListDrain(struct LinkedList* list, TYPE* out);
+
 // Bag interface
 
 void linkedListAdd(struct LinkedList* list, TYPE value);
 int linkedListContains(struct LinkedList* list, TYPE value);
 void linkedListRemove(struct LinkedList* list, TYPE value);
+void linkedListEnableIndex(struct LinkedList* list);
+void linkedListDisableIndex(struct LinkedList* list);
+
+// Cursor interface
+
+void linkedListCursorBegin(struct LinkedList* list, struct LinkedListCursor* cursor);
+void linkedListCursorLast(struct LinkedList* list, struct LinkedListCursor* cursor);
+int linkedListCursorValid(struct LinkedListCursor* cursor);
+void linkedListCursorNext(struct LinkedListCursor* cursor);
+void linkedListCursorPrev(struct LinkedListCursor* cursor);
+TYPE linkedListCursorGet(struct LinkedListCursor* cursor);
+void linkedListCursorRemove(struct LinkedListCursor* cursor);
+int linkedListForEach(struct LinkedList* list, int (*visit)(TYPE value, void* arg), void* arg);
+int linkedListRemoveIf(struct LinkedList* list, int (*match)(TYPE value, void* arg), void* arg);
+
+// Splice interface, O(1) relinking between lists that malloc their
+// links; pooled lists copy the values instead
+
+void linkedListConcat(struct LinkedList* list, struct LinkedList* other);
+void linkedListSplice(struct LinkedListCursor* position, struct LinkedListCursor* first,
+                      struct LinkedListCursor* last);
+void linkedListSplit(struct LinkedListCursor* cursor, struct LinkedList* other);
+
+// Ordered interface, values compare with LT and equal values keep the
+// order they were added in
+
+void linkedListSort(struct LinkedList* list);
+void linkedListAddSorted(struct LinkedList* list, TYPE value);
+void linkedListMerge(struct LinkedList* list, struct LinkedList* other);
+
+// Instrumentation interface
+
+void linkedListStats(struct LinkedList* list, struct LinkedListStats* stats);
+void linkedListStatsReset(struct LinkedList* list);
+void linkedListStatsPrint(struct LinkedList* list);
 
 #endif
\ No newline at end of file
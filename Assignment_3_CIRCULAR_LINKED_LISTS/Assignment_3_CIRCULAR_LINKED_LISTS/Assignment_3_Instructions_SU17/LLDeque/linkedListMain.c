@@ -1,6 +1,21 @@
 #include "linkedList.h"
 #include <stdio.h>
 
+// a list of doubles next to the TYPE list
+#define LIST_NAME LinkedList_f64
+#define LIST_TYPE double
+#include "linkedListTemplate.h"
+
+#include "intrusiveList.h"
+#include "compactList.h"
+
+// an object that can sit in one intrusive list at a time
+struct Job
+{
+	int id;
+	struct ListNode node;
+};
+
 int main(){
 	struct LinkedList* l = linkedListCreate(); 
 	linkedListAddFront(l, (TYPE)1);
@@ -25,6 +40,48 @@ int main(){
        linkedListRemove(k, (TYPE)11);
        linkedListPrint(k);
     
+/* TYPED LIST */
+
+    struct LinkedList_f64 halves;
+    LinkedList_f64_init(&halves);
+    for(int i = 0; i < 4; i++) LinkedList_f64_addBack(&halves, i * 0.5);
+    LinkedList_f64_remove(&halves, 0.5);
+    printf("%g %g %d\n", LinkedList_f64_front(&halves), LinkedList_f64_back(&halves),
+           LinkedList_f64_contains(&halves, 0.5));
+    LinkedList_f64_cleanup(&halves);
+
+/* INTRUSIVE LIST */
+
+    struct Job jobs[4];
+    struct IntrusiveList waiting, running;
+    struct ListNode* node;
+    intrusiveListInit(&waiting);
+    intrusiveListInit(&running);
+    for(int i = 0; i < 4; i++){
+        jobs[i].id = i;
+        listNodeInit(&jobs[i].node);
+        intrusiveListAddBack(&waiting, &jobs[i].node);
+    }
+    intrusiveListMoveBack(&waiting, &running, &jobs[2].node);
+    intrusiveListMoveBack(&waiting, &running, &jobs[0].node);
+    LIST_FOR_EACH(node, &running) printf("%d ", LIST_ENTRY(node, struct Job, node)->id);
+    printf("| ");
+    LIST_FOR_EACH(node, &waiting) printf("%d ", LIST_ENTRY(node, struct Job, node)->id);
+    printf("\n");
+
+/* COMPACT LIST */
+
+    struct CompactList* c = compactListCreate();
+    compactListAddBack(c, 20);
+    uint32_t handle = compactListAddBack(c, 21);
+    compactListAddFront(c, 19);
+    compactListRemove(c, handle);
+    for(uint32_t h = compactListFirst(c); h != 0; h = compactListNext(c, h)){
+        printf("%d ", compactListGet(c, h));
+    }
+    printf("\n");
+    compactListDestroy(c);
+
     linkedListDestroy(k);
     linkedListDestroy(l);
 	return 0;
@@ -0,0 +1,158 @@
+/***********************************************************
+* Filename:                     linkedListSnapshot.c
+*
+* Overview:
+*   This file contains the function definitions for saving a
+*   LinkedList to a binary snapshot file and loading it back.
+*   The file itself is handled by snapshotFile.c. Saving streams
+*   the values out in one pass through linkedListForEach.
+*   Loading maps the file, so the values can be read in place,
+*   or copied into a pooled list whose links all come from one
+*   page.
+*
+*
+* Input:
+*   A snapshot file path
+*
+* Output:
+*   A snapshot file
+************************************************************/
+
+// posix_madvise is POSIX, not C99
+#define _POSIX_C_SOURCE 200112L
+
+#include <assert.h>
+#include <sys/mman.h>
+#include "linkedListSnapshot.h"
+
+static const struct SnapshotFormat format = { "CS261LL", LINKED_LIST_SNAPSHOT_VERSION, sizeof(TYPE) };
+
+
+/*********************************************************************
+** Function: saveValue
+**
+** Description: linkedListForEach visitor that writes one value
+**
+** Parameters: the value and the snapshot writer
+**
+** Pre-Conditions:  called during snapshotFileSave
+** Post-Conditions: returns 0 to stop the walk once a write has failed
+*********************************************************************/
+static int saveValue(TYPE value, void* arg)
+{
+    return snapshotWrite(arg, &value);
+}
+
+/*********************************************************************
+** Function: saveList
+**
+** Description: walks the list front to back into the snapshot
+**
+** Parameters: the snapshot writer and list
+**
+** Pre-Conditions:  called by snapshotFileSave
+** Post-Conditions: every value has been written, or a write failed
+*********************************************************************/
+static void saveList(struct SnapshotWriter* writer, void* list)
+{
+    linkedListForEach(list, saveValue, writer);
+}
+
+/*********************************************************************
+** Function: linkedListSave
+**
+** Description: writes the list to path, front to back, replacing any
+**              earlier snapshot there only once it is complete
+**
+** Parameters: a list and file path
+**
+** Pre-Conditions:  list has been initialized
+** Post-Conditions: returns 0 on success, or -1 with errno set
+*********************************************************************/
+int linkedListSave(struct LinkedList* list, const char* path)
+{
+    assert(list!=0 && path!=0);
+    return snapshotFileSave(path, &format, saveList, list);
+}
+
+/*********************************************************************
+** Function: linkedListSnapshotOpen
+**
+** Description: maps a snapshot file read-only and checks that it was
+**              saved by a program with the same TYPE and byte order
+**
+** Parameters: a file path and the snapshot to fill in
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: returns 0 with the snapshot open, or -1 with errno
+**                  set, EINVAL if the file is not a usable snapshot
+*********************************************************************/
+int linkedListSnapshotOpen(const char* path, struct LinkedListSnapshot* snapshot)
+{
+    assert(path!=0 && snapshot!=0);
+    if(snapshotFileOpen(path, &format, &snapshot->file) != 0) return -1;
+
+    // the file is only read front to back from here
+    posix_madvise(snapshot->file.map, snapshot->file.length, POSIX_MADV_SEQUENTIAL);
+
+    snapshot->values = snapshot->file.values;
+    snapshot->count = snapshot->file.count;
+    return 0;
+}
+
+/*********************************************************************
+** Function: linkedListSnapshotClose
+**
+** Description: unmaps a snapshot, lists loaded from it are unaffected
+**
+** Parameters: an open snapshot
+**
+** Pre-Conditions:  the snapshot was opened by linkedListSnapshotOpen
+** Post-Conditions: the snapshot's values may no longer be read
+*********************************************************************/
+void linkedListSnapshotClose(struct LinkedListSnapshot* snapshot)
+{
+    assert(snapshot!=0);
+    snapshotFileClose(&snapshot->file);
+    snapshot->values = 0;
+    snapshot->count = 0;
+}
+
+/*********************************************************************
+** Function: linkedListSnapshotLoad
+**
+** Description: copies a snapshot's values into a new pooled list, all
+**              of its links are carved from a single page
+**
+** Parameters: an open snapshot
+**
+** Pre-Conditions:  the snapshot was opened by linkedListSnapshotOpen
+** Post-Conditions: returns the list, owned by the caller
+*********************************************************************/
+struct LinkedList* linkedListSnapshotLoad(struct LinkedListSnapshot* snapshot)
+{
+    assert(snapshot!=0 && snapshot->file.map!=0);
+    struct LinkedList* list = linkedListCreatePooled();
+    linkedListAddBackArray(list, snapshot->values, snapshot->count);
+    return list;
+}
+
+/*********************************************************************
+** Function: linkedListLoad
+**
+** Description: loads the list saved at path
+**
+** Parameters: a file path
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: returns the list, owned by the caller, or null with
+**                  errno set
+*********************************************************************/
+struct LinkedList* linkedListLoad(const char* path)
+{
+    struct LinkedListSnapshot snapshot;
+    if(linkedListSnapshotOpen(path, &snapshot) != 0) return 0;
+    struct LinkedList* list = linkedListSnapshotLoad(&snapshot);
+    linkedListSnapshotClose(&snapshot);
+    return list;
+}
@@ -0,0 +1,27 @@
+#ifndef LINKED_LIST_SNAPSHOT_H
+#define LINKED_LIST_SNAPSHOT_H
+
+#include "linkedList.h"
+#include "snapshotFile.h"
+
+// Snapshot files as described in CLDeque/snapshotFile.h, holding
+// the values front to back
+#define LINKED_LIST_SNAPSHOT_VERSION 1
+
+// Snapshot file mapped read-only, values[0 .. count-1] can be read in
+// place until the snapshot is closed
+struct LinkedListSnapshot
+{
+	const TYPE* values;
+	int count;
+	struct SnapshotFile file;
+};
+
+int linkedListSave(struct LinkedList* list, const char* path);
+struct LinkedList* linkedListLoad(const char* path);
+
+int linkedListSnapshotOpen(const char* path, struct LinkedListSnapshot* snapshot);
+void linkedListSnapshotClose(struct LinkedListSnapshot* snapshot);
+struct LinkedList* linkedListSnapshotLoad(struct LinkedListSnapshot* snapshot);
+
+#endif
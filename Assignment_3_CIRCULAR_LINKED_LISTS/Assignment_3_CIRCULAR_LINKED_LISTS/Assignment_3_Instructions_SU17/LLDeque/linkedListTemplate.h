@@ -0,0 +1,279 @@
+/***********************************************************
+* Filename:                     linkedListTemplate.h
+*
+* Overview:
+*   Generates a linked list deque and bag for one element type,
+*   so one program can hold lists of several types without the
+*   global TYPE macro or boxing values through void*. Define
+*   LIST_NAME and LIST_TYPE, and LIST_EQ if == does not fit,
+*   then include this file; it can be included again for every
+*   type needed:
+*
+*       #define LIST_NAME LinkedList_u64
+*       #define LIST_TYPE uint64_t
+*       #include "linkedListTemplate.h"
+*
+*   This declares struct LinkedList_u64 and functions named
+*   LinkedList_u64_addBack, LinkedList_u64_contains and so on.
+*   Every function is static inline, so the compiler can inline
+*   them into callers in any file that includes the header.
+*   Removed links are kept on the list's spares and reused, and
+*   are only freed by cleanup or destroy.
+************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+
+#if !defined(LIST_NAME) || !defined(LIST_TYPE)
+#error "define LIST_NAME and LIST_TYPE before including linkedListTemplate.h"
+#endif
+
+#ifndef LIST_EQ
+#define LIST_EQ(A, B) ((A) == (B))
+#endif
+
+#define LIST_JOIN2(A, B) A##_##B
+#define LIST_JOIN(A, B) LIST_JOIN2(A, B)
+#define LIST_FN(NAME) LIST_JOIN(LIST_NAME, NAME)
+#define LIST_LINK LIST_JOIN(LIST_NAME, Link)
+
+// Double link
+struct LIST_LINK
+{
+	LIST_TYPE value;
+	struct LIST_LINK * next;
+	struct LIST_LINK * prev;
+};
+
+// The sentinel lives in the list itself, so a list must not be moved
+// once it has been initialized
+struct LIST_NAME
+{
+	int size;
+	struct LIST_LINK sentinel;
+	struct LIST_LINK* spares;
+};
+
+
+/*********************************************************************
+** Function: init
+**
+** Description: sets up an empty list in memory the caller owns
+**
+** Parameters:  a list structure
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: the list is empty
+********************************************************************/
+static inline void LIST_FN(init)(struct LIST_NAME* list)
+{
+    assert(list!=0);
+    list->size = 0;
+    list->sentinel.next = &list->sentinel;
+    list->sentinel.prev = &list->sentinel;
+    list->spares = 0;
+}
+
+/*********************************************************************
+** Function: cleanup
+**
+** Description: frees every link, in use or spare, but not the list
+**
+** Parameters:  a list
+**
+** Pre-Conditions:  the list has been initialized
+** Post-Conditions: the list must be initialized again before use
+********************************************************************/
+static inline void LIST_FN(cleanup)(struct LIST_NAME* list)
+{
+    assert(list!=0);
+    struct LIST_LINK* link = list->sentinel.next;
+    while(link != &list->sentinel){
+        struct LIST_LINK* next = link->next;
+        free(link);
+        link = next;
+    }
+    while(list->spares != 0){
+        link = list->spares;
+        list->spares = link->next;
+        free(link);
+    }
+}
+
+/*********************************************************************
+** Function: create
+**
+** Description: allocates and initializes an empty list
+**
+** Parameters:  NONE
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: the returned list is owned by the caller
+********************************************************************/
+static inline struct LIST_NAME* LIST_FN(create)(void)
+{
+    struct LIST_NAME* list = (struct LIST_NAME*)malloc(sizeof(struct LIST_NAME));
+    assert(list!=0);
+    LIST_FN(init)(list);
+    return list;
+}
+
+/*********************************************************************
+** Function: destroy
+**
+** Description: frees a list made by create and all of its links
+**
+** Parameters:  a list
+**
+** Pre-Conditions:  the list came from create
+** Post-Conditions: the list has been freed
+********************************************************************/
+static inline void LIST_FN(destroy)(struct LIST_NAME* list)
+{
+    LIST_FN(cleanup)(list);
+    free(list);
+}
+
+static inline int LIST_FN(size)(struct LIST_NAME* list)
+{
+    assert(list!=0);
+    return list->size;
+}
+
+static inline int LIST_FN(isEmpty)(struct LIST_NAME* list)
+{
+    assert(list!=0);
+    return list->size == 0;
+}
+
+/*********************************************************************
+** Function: addLinkBefore
+**
+** Description: puts a link holding value before the given link,
+**              taking a spare link if there is one
+**
+** Parameters:  a list, a link in it or its sentinel, and the value
+**
+** Pre-Conditions:  the list has been initialized
+** Post-Conditions: size has grown by one
+********************************************************************/
+static inline void LIST_FN(addLinkBefore)(struct LIST_NAME* list, struct LIST_LINK* link,
+                                          LIST_TYPE value)
+{
+    struct LIST_LINK* newLink = list->spares;
+    if(newLink != 0) list->spares = newLink->next;
+    else {
+        newLink = (struct LIST_LINK*)malloc(sizeof(struct LIST_LINK));
+        assert(newLink!=0);
+    }
+    newLink->value = value;
+    newLink->next = link;
+    newLink->prev = link->prev;
+    link->prev->next = newLink;
+    link->prev = newLink;
+    list->size++;
+}
+
+/*********************************************************************
+** Function: removeLink
+**
+** Description: unlinks a link and keeps it as a spare
+**
+** Parameters:  a list and one of its links
+**
+** Pre-Conditions:  link is in the list and is not the sentinel
+** Post-Conditions: size has shrunk by one
+********************************************************************/
+static inline void LIST_FN(removeLink)(struct LIST_NAME* list, struct LIST_LINK* link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next = list->spares;
+    list->spares = link;
+    list->size--;
+}
+
+// Deque interface
+
+static inline void LIST_FN(addFront)(struct LIST_NAME* list, LIST_TYPE value)
+{
+    assert(list!=0);
+    LIST_FN(addLinkBefore)(list, list->sentinel.next, value);
+}
+
+static inline void LIST_FN(addBack)(struct LIST_NAME* list, LIST_TYPE value)
+{
+    assert(list!=0);
+    LIST_FN(addLinkBefore)(list, &list->sentinel, value);
+}
+
+static inline LIST_TYPE LIST_FN(front)(struct LIST_NAME* list)
+{
+    assert(list!=0 && list->size>0);
+    return list->sentinel.next->value;
+}
+
+static inline LIST_TYPE LIST_FN(back)(struct LIST_NAME* list)
+{
+    assert(list!=0 && list->size>0);
+    return list->sentinel.prev->value;
+}
+
+static inline void LIST_FN(removeFront)(struct LIST_NAME* list)
+{
+    assert(list!=0 && list->size>0);
+    LIST_FN(removeLink)(list, list->sentinel.next);
+}
+
+static inline void LIST_FN(removeBack)(struct LIST_NAME* list)
+{
+    assert(list!=0 && list->size>0);
+    LIST_FN(removeLink)(list, list->sentinel.prev);
+}
+
+// Bag interface, the same order as linkedListAdd/Contains/Remove
+
+static inline void LIST_FN(add)(struct LIST_NAME* list, LIST_TYPE value)
+{
+    LIST_FN(addBack)(list, value);
+}
+
+static inline int LIST_FN(contains)(struct LIST_NAME* list, LIST_TYPE value)
+{
+    assert(list!=0);
+    for(struct LIST_LINK* link = list->sentinel.next; link != &list->sentinel; link = link->next){
+        if(LIST_EQ(value, link->value)) return 1;
+    }
+    return 0;
+}
+
+/*********************************************************************
+** Function: remove
+**
+** Description: removes the first link holding value, if any
+**
+** Parameters:  a list and value
+**
+** Pre-Conditions:  the list has been initialized
+** Post-Conditions: returns 1 if a link was removed and 0 if not
+********************************************************************/
+static inline int LIST_FN(remove)(struct LIST_NAME* list, LIST_TYPE value)
+{
+    assert(list!=0);
+    for(struct LIST_LINK* link = list->sentinel.next; link != &list->sentinel; link = link->next){
+        if(LIST_EQ(value, link->value)){
+            LIST_FN(removeLink)(list, link);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// ready for the next instantiation
+#undef LIST_NAME
+#undef LIST_TYPE
+#undef LIST_EQ
+#undef LIST_JOIN2
+#undef LIST_JOIN
+#undef LIST_FN
+#undef LIST_LINK
@@ -0,0 +1,300 @@
+/***********************************************************
+* Filename:                     ringQueue.c
+*
+* Overview:
+*   This file contains the function definitions for a bounded
+*   lock-free queue kept in a power of two ring of cells. Any
+*   number of threads may add and remove at once (Vyukov's
+*   sequence numbered cells); a queue created in SPSC mode
+*   drops the per-cell handshake for one producer and one
+*   consumer.
+*
+*
+* Input:
+*   No input is required.
+*
+* Output:
+*   No output
+************************************************************/
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include "ringQueue.h"
+
+// Size of a cache line, counters that different threads write are kept
+// on lines of their own
+#ifndef CACHE_LINE
+#define CACHE_LINE 64
+#endif
+
+// Slot in the ring, sequence tells which lap of the ring may use it next
+struct Cell
+{
+	atomic_size_t sequence;
+	TYPE value;
+};
+
+struct RingQueue
+{
+	struct Cell* cells;
+	size_t mask;
+	int mode;
+
+	// producers claim positions from tail, consumers from head
+	_Alignas(CACHE_LINE) atomic_size_t tail;
+	_Alignas(CACHE_LINE) atomic_size_t head;
+
+	// the SPSC producer's and consumer's last view of the other end
+	_Alignas(CACHE_LINE) size_t cachedHead;
+	_Alignas(CACHE_LINE) size_t cachedTail;
+};
+
+
+/*********************************************************************
+** Function: ringQueueCreate
+**
+** Description: allocates a queue holding up to capacity values,
+**              rounded up to a power of two
+**
+** Parameters:  the capacity and RING_QUEUE_MPMC or RING_QUEUE_SPSC
+**
+** Pre-Conditions:  capacity is at least 2
+** Post-Conditions: returns an empty queue
+********************************************************************/
+struct RingQueue* ringQueueCreate(int capacity, int mode)
+{
+    assert(capacity>=2);
+    assert(mode==RING_QUEUE_MPMC || mode==RING_QUEUE_SPSC);
+
+    size_t size = 2;
+    while(size < (size_t)capacity) size *= 2;
+
+    struct RingQueue* queue = aligned_alloc(CACHE_LINE, sizeof(struct RingQueue));
+    assert(queue!=0);
+    queue->cells = malloc(size * sizeof(struct Cell));
+    assert(queue->cells!=0);
+    queue->mask = size - 1;
+    queue->mode = mode;
+
+    // cell i is free for the producer that claims position i
+    for(size_t i = 0; i < size; i++){
+        atomic_init(&queue->cells[i].sequence, i);
+    }
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    queue->cachedHead = 0;
+    queue->cachedTail = 0;
+    return queue;
+}
+
+/*********************************************************************
+** Function: ringQueueDestroy
+**
+** Description: frees the queue and its cells
+**
+** Parameters:  a RingQueue
+**
+** Pre-Conditions:  no thread is using the queue
+** Post-Conditions: the queue has been freed
+********************************************************************/
+void ringQueueDestroy(struct RingQueue* queue)
+{
+    assert(queue!=0);
+    free(queue->cells);
+    free(queue);
+}
+
+/*********************************************************************
+** Function: ringQueueCapacity
+**
+** Description: returns how many values the queue can hold
+**
+** Parameters:  a RingQueue
+**
+** Pre-Conditions:  queue has been created
+** Post-Conditions: NONE
+********************************************************************/
+int ringQueueCapacity(struct RingQueue* queue)
+{
+    assert(queue!=0);
+    return (int)(queue->mask + 1);
+}
+
+/*********************************************************************
+** Function: addBackSingle
+**
+** Description: SPSC add, only the producer writes tail, so no compare
+**              and swap or per-cell handshake is needed
+**
+** Parameters:  a RingQueue and value
+**
+** Pre-Conditions:  called by the queue's only producer
+** Post-Conditions: returns 1 if the value was added, 0 if full
+********************************************************************/
+static int addBackSingle(struct RingQueue* queue, TYPE value)
+{
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+    // only reload head when the cached view says the ring is full
+    if(tail - queue->cachedHead > queue->mask){
+        queue->cachedHead = atomic_load_explicit(&queue->head, memory_order_acquire);
+        if(tail - queue->cachedHead > queue->mask) return 0;
+    }
+
+    queue->cells[tail & queue->mask].value = value;
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    return 1;
+}
+
+/*********************************************************************
+** Function: removeFrontSingle
+**
+** Description: SPSC remove, only the consumer writes head
+**
+** Parameters:  a RingQueue and where to store the value
+**
+** Pre-Conditions:  called by the queue's only consumer
+** Post-Conditions: returns 1 if a value was removed, 0 if empty
+********************************************************************/
+static int removeFrontSingle(struct RingQueue* queue, TYPE* value)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+    // only reload tail when the cached view says the ring is empty
+    if(head == queue->cachedTail){
+        queue->cachedTail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        if(head == queue->cachedTail) return 0;
+    }
+
+    *value = queue->cells[head & queue->mask].value;
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return 1;
+}
+
+/*********************************************************************
+** Function: ringQueueAddBack
+**
+** Description: adds a value to the back of the queue without blocking
+**
+** Parameters:  a RingQueue and value
+**
+** Pre-Conditions:  queue has been created
+** Post-Conditions: returns 1 if the value was added, 0 if the queue
+**                  was full
+********************************************************************/
+int ringQueueAddBack(struct RingQueue* queue, TYPE value)
+{
+    assert(queue!=0);
+    if(queue->mode == RING_QUEUE_SPSC) return addBackSingle(queue, value);
+
+    size_t position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    struct Cell* cell;
+    for(;;){
+        cell = &queue->cells[position & queue->mask];
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        ptrdiff_t lap = (ptrdiff_t)sequence - (ptrdiff_t)position;
+
+        if(lap == 0){
+            // the cell is free on this lap, try to claim the position
+            if(atomic_compare_exchange_weak_explicit(&queue->tail, &position, position + 1,
+                                                     memory_order_relaxed, memory_order_relaxed)){
+                break;
+            }
+        }
+        else if(lap < 0){
+            // the consumer of the previous lap has not freed it yet
+            return 0;
+        }
+        else {
+            position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        }
+    }
+
+    cell->value = value;
+    atomic_store_explicit(&cell->sequence, position + 1, memory_order_release);
+    return 1;
+}
+
+/*********************************************************************
+** Function: ringQueueRemoveFront
+**
+** Description: removes the value at the front of the queue without
+**              blocking
+**
+** Parameters:  a RingQueue and where to store the value
+**
+** Pre-Conditions:  queue has been created
+** Post-Conditions: returns 1 if a value was removed, 0 if the queue
+**                  was empty
+********************************************************************/
+int ringQueueRemoveFront(struct RingQueue* queue, TYPE* value)
+{
+    assert(queue!=0 && value!=0);
+    if(queue->mode == RING_QUEUE_SPSC) return removeFrontSingle(queue, value);
+
+    size_t position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    struct Cell* cell;
+    for(;;){
+        cell = &queue->cells[position & queue->mask];
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        ptrdiff_t lap = (ptrdiff_t)sequence - (ptrdiff_t)(position + 1);
+
+        if(lap == 0){
+            // the cell holds a value on this lap, try to claim it
+            if(atomic_compare_exchange_weak_explicit(&queue->head, &position, position + 1,
+                                                     memory_order_relaxed, memory_order_relaxed)){
+                break;
+            }
+        }
+        else if(lap < 0){
+            // no producer has filled it yet
+            return 0;
+        }
+        else {
+            position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+        }
+    }
+
+    *value = cell->value;
+
+    // free the cell for the producer one lap ahead
+    atomic_store_explicit(&cell->sequence, position + queue->mask + 1, memory_order_release);
+    return 1;
+}
+
+/*********************************************************************
+** Function: ringQueueSize
+**
+** Description: returns the number of values in the queue, only a
+**              snapshot while other threads are using it
+**
+** Parameters:  a RingQueue
+**
+** Pre-Conditions:  queue has been created
+** Post-Conditions: NONE
+********************************************************************/
+int ringQueueSize(struct RingQueue* queue)
+{
+    assert(queue!=0);
+    size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    return tail > head ? (int)(tail - head) : 0;
+}
+
+/*********************************************************************
+** Function: ringQueueIsEmpty
+**
+** Description: returns 1 if the queue is empty and 0 if not, only a
+**              snapshot while other threads are using it
+**
+** Parameters:  a RingQueue
+**
+** Pre-Conditions:  queue has been created
+** Post-Conditions: NONE
+********************************************************************/
+int ringQueueIsEmpty(struct RingQueue* queue)
+{
+    return ringQueueSize(queue) == 0;
+}
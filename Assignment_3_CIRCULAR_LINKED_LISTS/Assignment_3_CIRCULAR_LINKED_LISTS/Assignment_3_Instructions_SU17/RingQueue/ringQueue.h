@@ -0,0 +1,26 @@
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#ifndef TYPE
+#define TYPE double
+#endif
+
+// Who may touch a queue at once
+#define RING_QUEUE_MPMC 0
+#define RING_QUEUE_SPSC 1
+
+struct RingQueue;
+
+struct RingQueue* ringQueueCreate(int capacity, int mode);
+void ringQueueDestroy(struct RingQueue* queue);
+int ringQueueCapacity(struct RingQueue* queue);
+
+// Queue interface, safe to call from several threads at once. In
+// RING_QUEUE_SPSC mode only one thread may add and one may remove.
+
+int ringQueueAddBack(struct RingQueue* queue, TYPE value);
+int ringQueueRemoveFront(struct RingQueue* queue, TYPE* value);
+int ringQueueSize(struct RingQueue* queue);
+int ringQueueIsEmpty(struct RingQueue* queue);
+
+#endif
@@ -0,0 +1,111 @@
+/***********************************************************
+* Filename:                     ringQueueBench.c
+*
+* Overview:
+*   Measures RingQueue throughput with 1 to N producer and
+*   consumer threads each, plus the SPSC fast path. Prints
+*   one CSV row per run.
+*
+* Input:
+*   [max threads per side] [values per producer]
+*
+* Output:
+*   CSV on stdout
+************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include "ringQueue.h"
+
+struct Run
+{
+	struct RingQueue* queue;
+	long perProducer;
+	long total;
+	atomic_long consumed;
+	atomic_long sum;
+};
+
+static void* produce(void* arg)
+{
+	struct Run* run = arg;
+	for(long i = 0; i < run->perProducer; i++){
+		while(!ringQueueAddBack(run->queue, (TYPE)i)) sched_yield();
+	}
+	return 0;
+}
+
+static void* consume(void* arg)
+{
+	struct Run* run = arg;
+	long sum = 0;
+	TYPE value;
+	while(atomic_load_explicit(&run->consumed, memory_order_relaxed) < run->total){
+		if(ringQueueRemoveFront(run->queue, &value)){
+			sum += (long)value;
+			atomic_fetch_add_explicit(&run->consumed, 1, memory_order_relaxed);
+		}
+		else sched_yield();
+	}
+	atomic_fetch_add(&run->sum, sum);
+	return 0;
+}
+
+static double now()
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void bench(int mode, int threads, long perProducer)
+{
+	struct Run run;
+	run.queue = ringQueueCreate(1 << 14, mode);
+	run.perProducer = perProducer;
+	run.total = perProducer * threads;
+	atomic_init(&run.consumed, 0);
+	atomic_init(&run.sum, 0);
+
+	pthread_t producers[threads], consumers[threads];
+	double start = now();
+	for(int i = 0; i < threads; i++){
+		pthread_create(&consumers[i], 0, consume, &run);
+		pthread_create(&producers[i], 0, produce, &run);
+	}
+	for(int i = 0; i < threads; i++){
+		pthread_join(producers[i], 0);
+		pthread_join(consumers[i], 0);
+	}
+	double seconds = now() - start;
+
+	// every value pushed must come out exactly once
+	long expected = threads * (perProducer * (perProducer - 1) / 2);
+	if(atomic_load(&run.sum) != expected){
+		fprintf(stderr, "lost or duplicated values\n");
+		exit(1);
+	}
+
+	printf("%s,%d,%d,%ld,%.6f,%.2f,%.0f\n", mode == RING_QUEUE_SPSC ? "spsc" : "mpmc",
+	       threads, threads, run.total, seconds, seconds * 1e9 / run.total, run.total / seconds);
+	ringQueueDestroy(run.queue);
+}
+
+int main(int argc, char** argv)
+{
+	int maxThreads = argc > 1 ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+	long perProducer = argc > 2 ? atol(argv[2]) : 2000000;
+	if(maxThreads < 1) maxThreads = 1;
+
+	printf("mode,producers,consumers,operations,seconds,ns_per_op,ops_per_sec\n");
+	bench(RING_QUEUE_SPSC, 1, perProducer);
+	for(int threads = 1; threads <= maxThreads; threads++){
+		bench(RING_QUEUE_MPMC, threads, perProducer);
+	}
+	return 0;
+}
@@ -0,0 +1,21 @@
+#include "ringQueue.h"
+#include <stdio.h>
+
+int main()
+{
+	struct RingQueue* queue = ringQueueCreate(4, RING_QUEUE_MPMC);
+	TYPE value;
+	
+	for(int i = 1; i <= 5; i++){
+		if(!ringQueueAddBack(queue, (TYPE)i)) printf("full at %d\n", i);
+	}
+	printf("%d\n", ringQueueSize(queue));
+	
+	while(ringQueueRemoveFront(queue, &value)){
+		printf("%g ", value);
+	}
+	printf("\n%d\n", ringQueueIsEmpty(queue));
+	
+	ringQueueDestroy(queue);
+	return 0;
+}
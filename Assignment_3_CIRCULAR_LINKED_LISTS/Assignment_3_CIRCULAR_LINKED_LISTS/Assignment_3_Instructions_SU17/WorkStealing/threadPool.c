@@ -0,0 +1,372 @@
+/***********************************************************
+* Filename:                     threadPool.c
+*
+* Overview:
+*   This file contains the function definitions for a small
+*   fork-join thread pool. Every worker owns a WorkDeque: tasks
+*   it spawns go on the back of its own deque, and a worker
+*   that runs dry steals from the front of a random victim's.
+*   Tasks spawned from outside the pool go through a shared
+*   injection queue. A worker waiting on a task keeps running
+*   other tasks until it is done.
+*
+*
+* Input:
+*   No input is required.
+*
+* Output:
+*   No output
+************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "threadPool.h"
+#include "workDeque.h"
+
+// How long an idle worker sleeps before looking for work again
+#ifndef IDLE_WAIT_NS
+#define IDLE_WAIT_NS 1000000
+#endif
+
+struct Worker
+{
+	struct ThreadPool* pool;
+	struct WorkDeque* deque;
+	pthread_t thread;
+	unsigned int seed;
+};
+
+struct ThreadPool
+{
+	int count;
+	struct Worker* workers;
+
+	// tasks spawned by threads outside the pool
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	pthread_cond_t finished;
+	struct Task* injectHead;
+	struct Task* injectTail;
+
+	atomic_int sleepers;
+	atomic_int outsideWaiters;
+	atomic_int stopping;
+};
+
+// worker the calling thread is, if any
+static _Thread_local struct Worker* currentWorker;
+
+
+/*********************************************************************
+** Function: taskInit
+**
+** Description: sets up a task that calls run(arg)
+**
+** Parameters:  a Task, the function to run and its argument
+**
+** Pre-Conditions:  the task is not spawned
+** Post-Conditions: the task is ready to be spawned
+********************************************************************/
+void taskInit(struct Task* task, void (*run)(void* arg), void* arg)
+{
+    assert(task!=0 && run!=0);
+    task->run = run;
+    task->arg = arg;
+    atomic_init(&task->done, 0);
+    task->next = 0;
+}
+
+/*********************************************************************
+** Function: takeInjected
+**
+** Description: removes the oldest task spawned from outside the pool
+**
+** Parameters:  a ThreadPool
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: returns the task or null
+********************************************************************/
+static struct Task* takeInjected(struct ThreadPool* pool)
+{
+    // peek without the lock, most of the time there is nothing
+    if(__atomic_load_n(&pool->injectHead, __ATOMIC_RELAXED) == 0) return 0;
+
+    pthread_mutex_lock(&pool->lock);
+    struct Task* task = pool->injectHead;
+    if(task!=0){
+        __atomic_store_n(&pool->injectHead, task->next, __ATOMIC_RELAXED);
+        if(pool->injectHead == 0) pool->injectTail = 0;
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return task;
+}
+
+/*********************************************************************
+** Function: findTask
+**
+** Description: looks for a task in the worker's own deque, then in the
+**              deques of the other workers starting at a random one,
+**              then in the injection queue
+**
+** Parameters:  a Worker
+**
+** Pre-Conditions:  called by the worker's own thread
+** Post-Conditions: returns the task or null
+********************************************************************/
+static struct Task* findTask(struct Worker* worker)
+{
+    struct Task* task = workDequePopBack(worker->deque);
+    if(task!=0) return task;
+
+    struct ThreadPool* pool = worker->pool;
+    // xorshift picks where to start so thieves spread over the victims
+    worker->seed ^= worker->seed << 13;
+    worker->seed ^= worker->seed >> 17;
+    worker->seed ^= worker->seed << 5;
+    int start = worker->seed % pool->count;
+    for(int i = 0; i < pool->count; i++){
+        struct Worker* victim = &pool->workers[(start + i) % pool->count];
+        if(victim == worker) continue;
+        task = workDequeStealFront(victim->deque);
+        if(task!=0) return task;
+    }
+    return takeInjected(pool);
+}
+
+/*********************************************************************
+** Function: runTask
+**
+** Description: runs a task and marks it done, waking threads outside
+**              the pool that may be waiting on it
+**
+** Parameters:  a ThreadPool and Task
+**
+** Pre-Conditions:  the task has been taken from a queue
+** Post-Conditions: the task is done
+********************************************************************/
+static void runTask(struct ThreadPool* pool, struct Task* task)
+{
+    task->run(task->arg);
+
+    // seq_cst on both sides: paired with the waiter's increment and load
+    // of done, at least one of us sees the other's store
+    atomic_store_explicit(&task->done, 1, memory_order_seq_cst);
+
+    if(atomic_load(&pool->outsideWaiters) > 0){
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->finished);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+/*********************************************************************
+** Function: idleWait
+**
+** Description: parks an idle worker until a task is spawned, the pool
+**              stops, or a short timeout passes
+**
+** Parameters:  a ThreadPool
+**
+** Pre-Conditions:  the worker found no task
+** Post-Conditions: NONE
+********************************************************************/
+static void idleWait(struct ThreadPool* pool)
+{
+    struct timespec until;
+    clock_gettime(CLOCK_REALTIME, &until);
+    until.tv_nsec += IDLE_WAIT_NS;
+    if(until.tv_nsec >= 1000000000){
+        until.tv_sec++;
+        until.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    atomic_fetch_add(&pool->sleepers, 1);
+    if(pool->injectHead == 0 && !atomic_load(&pool->stopping)){
+        pthread_cond_timedwait(&pool->wake, &pool->lock, &until);
+    }
+    atomic_fetch_sub(&pool->sleepers, 1);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/*********************************************************************
+** Function: workerMain
+**
+** Description: runs tasks until the pool stops
+**
+** Parameters:  the Worker
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: NONE
+********************************************************************/
+static void* workerMain(void* arg)
+{
+    struct Worker* worker = arg;
+    struct ThreadPool* pool = worker->pool;
+    currentWorker = worker;
+
+    while(!atomic_load_explicit(&pool->stopping, memory_order_acquire)){
+        struct Task* task = findTask(worker);
+        if(task!=0) runTask(pool, task);
+        else idleWait(pool);
+    }
+    return 0;
+}
+
+/*********************************************************************
+** Function: threadPoolCreate
+**
+** Description: starts a pool of worker threads, each with its own
+**              work-stealing deque
+**
+** Parameters:  the number of workers
+**
+** Pre-Conditions:  workers is positive
+** Post-Conditions: returns the running pool
+********************************************************************/
+struct ThreadPool* threadPoolCreate(int workers)
+{
+    assert(workers>0);
+
+    struct ThreadPool* pool = malloc(sizeof(struct ThreadPool));
+    assert(pool!=0);
+    pool->count = workers;
+    pool->workers = malloc(workers * sizeof(struct Worker));
+    assert(pool->workers!=0);
+    pthread_mutex_init(&pool->lock, 0);
+    pthread_cond_init(&pool->wake, 0);
+    pthread_cond_init(&pool->finished, 0);
+    pool->injectHead = 0;
+    pool->injectTail = 0;
+    atomic_init(&pool->sleepers, 0);
+    atomic_init(&pool->outsideWaiters, 0);
+    atomic_init(&pool->stopping, 0);
+
+    // every deque exists before any worker may try to steal from it
+    for(int i = 0; i < workers; i++){
+        pool->workers[i].pool = pool;
+        pool->workers[i].deque = workDequeCreate(64);
+        pool->workers[i].seed = (unsigned int)i * 2654435761u + 1;
+    }
+    for(int i = 0; i < workers; i++){
+        pthread_create(&pool->workers[i].thread, 0, workerMain, &pool->workers[i]);
+    }
+    return pool;
+}
+
+/*********************************************************************
+** Function: threadPoolDestroy
+**
+** Description: stops and joins every worker and frees the pool
+**
+** Parameters:  a ThreadPool
+**
+** Pre-Conditions:  every spawned task has been waited on
+** Post-Conditions: the pool has been freed
+********************************************************************/
+void threadPoolDestroy(struct ThreadPool* pool)
+{
+    assert(pool!=0);
+
+    pthread_mutex_lock(&pool->lock);
+    atomic_store(&pool->stopping, 1);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for(int i = 0; i < pool->count; i++){
+        pthread_join(pool->workers[i].thread, 0);
+        workDequeDestroy(pool->workers[i].deque);
+    }
+    pthread_cond_destroy(&pool->finished);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+/*********************************************************************
+** Function: threadPoolSpawn
+**
+** Description: forks a task, onto the calling worker's own deque or,
+**              from outside the pool, onto the injection queue
+**
+** Parameters:  a ThreadPool and Task
+**
+** Pre-Conditions:  the task has been initialized with taskInit
+** Post-Conditions: the task will be run by some worker
+********************************************************************/
+void threadPoolSpawn(struct ThreadPool* pool, struct Task* task)
+{
+    assert(pool!=0 && task!=0);
+
+    struct Worker* worker = currentWorker;
+    if(worker!=0 && worker->pool == pool){
+        // owner fast path, no lock and no compare and swap
+        workDequePushBack(worker->deque, task);
+        if(atomic_load_explicit(&pool->sleepers, memory_order_relaxed) > 0){
+            pthread_cond_signal(&pool->wake);
+        }
+        return;
+    }
+
+    task->next = 0;
+    pthread_mutex_lock(&pool->lock);
+    if(pool->injectTail!=0) pool->injectTail->next = task;
+    else __atomic_store_n(&pool->injectHead, task, __ATOMIC_RELAXED);
+    pool->injectTail = task;
+    pthread_cond_signal(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/*********************************************************************
+** Function: threadPoolWait
+**
+** Description: joins a spawned task; a worker keeps running other
+**              tasks while it waits, any other thread sleeps
+**
+** Parameters:  a ThreadPool and Task
+**
+** Pre-Conditions:  the task has been spawned on this pool
+** Post-Conditions: the task is done
+********************************************************************/
+void threadPoolWait(struct ThreadPool* pool, struct Task* task)
+{
+    assert(pool!=0 && task!=0);
+
+    struct Worker* worker = currentWorker;
+    if(worker!=0 && worker->pool == pool){
+        while(!atomic_load_explicit(&task->done, memory_order_acquire)){
+            struct Task* other = findTask(worker);
+            if(other!=0) runTask(pool, other);
+            else sched_yield();
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    atomic_fetch_add(&pool->outsideWaiters, 1);
+    while(!atomic_load_explicit(&task->done, memory_order_seq_cst)){
+        pthread_cond_wait(&pool->finished, &pool->lock);
+    }
+    atomic_fetch_sub(&pool->outsideWaiters, 1);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/*********************************************************************
+** Function: threadPoolRun
+**
+** Description: spawns a task and waits for it
+**
+** Parameters:  a ThreadPool and Task
+**
+** Pre-Conditions:  the task has been initialized with taskInit
+** Post-Conditions: the task is done
+********************************************************************/
+void threadPoolRun(struct ThreadPool* pool, struct Task* task)
+{
+    threadPoolSpawn(pool, task);
+    threadPoolWait(pool, task);
+}
@@ -0,0 +1,28 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdatomic.h>
+
+// Unit of work, owned by the caller until threadPoolWait returns
+struct Task
+{
+	void (*run)(void* arg);
+	void* arg;
+	atomic_int done;
+	struct Task* next;
+};
+
+struct ThreadPool;
+
+void taskInit(struct Task* task, void (*run)(void* arg), void* arg);
+
+struct ThreadPool* threadPoolCreate(int workers);
+void threadPoolDestroy(struct ThreadPool* pool);
+
+// Fork-join interface
+
+void threadPoolSpawn(struct ThreadPool* pool, struct Task* task);
+void threadPoolWait(struct ThreadPool* pool, struct Task* task);
+void threadPoolRun(struct ThreadPool* pool, struct Task* task);
+
+#endif
@@ -0,0 +1,44 @@
+#include "threadPool.h"
+#include <stdio.h>
+
+struct Fib
+{
+	struct ThreadPool* pool;
+	int n;
+	long result;
+};
+
+// fork fib(n-1), compute fib(n-2) in place, then join
+static void fib(void* arg)
+{
+	struct Fib* job = arg;
+	if(job->n < 2){
+		job->result = job->n;
+		return;
+	}
+	
+	struct Fib left = { job->pool, job->n - 1, 0 };
+	struct Fib right = { job->pool, job->n - 2, 0 };
+	struct Task task;
+	taskInit(&task, fib, &left);
+	threadPoolSpawn(job->pool, &task);
+	fib(&right);
+	threadPoolWait(job->pool, &task);
+	job->result = left.result + right.result;
+}
+
+int main()
+{
+	struct ThreadPool* pool = threadPoolCreate(4);
+	
+	for(int n = 10; n <= 25; n += 5){
+		struct Fib job = { pool, n, 0 };
+		struct Task task;
+		taskInit(&task, fib, &job);
+		threadPoolRun(pool, &task);
+		printf("fib(%d) = %ld\n", n, job.result);
+	}
+	
+	threadPoolDestroy(pool);
+	return 0;
+}
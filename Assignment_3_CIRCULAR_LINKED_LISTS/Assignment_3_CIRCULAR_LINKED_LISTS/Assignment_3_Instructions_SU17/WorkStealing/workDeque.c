@@ -0,0 +1,253 @@
+/***********************************************************
+* Filename:                     workDeque.c
+*
+* Overview:
+*   This file contains the function definitions for a Chase-Lev
+*   work-stealing deque of non-null pointers, following the C11
+*   version by Le, Pop, Cohen and Zappa Nardelli. The owner
+*   pushes and pops at the back without any compare and swap
+*   unless it races a thief for the last item; thieves take
+*   from the front.
+*
+*
+* Input:
+*   No input is required.
+*
+* Output:
+*   No output
+************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include "workDeque.h"
+
+#ifndef CACHE_LINE
+#define CACHE_LINE 64
+#endif
+
+// Power of two ring of items, arrays the deque has outgrown are kept on
+// older until the deque is destroyed since a thief may still read them
+struct WorkArray
+{
+	long size;
+	struct WorkArray* older;
+	_Atomic(void*) items[];
+};
+
+struct WorkDeque
+{
+	// thieves advance top, the owner moves bottom
+	_Alignas(CACHE_LINE) atomic_long top;
+	_Alignas(CACHE_LINE) atomic_long bottom;
+	_Atomic(struct WorkArray*) array;
+};
+
+
+/*********************************************************************
+** Function: createArray
+**
+** Description: allocates an empty ring of size items
+**
+** Parameters:  the size, a power of two
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: the returned array is owned by the caller
+********************************************************************/
+static struct WorkArray* createArray(long size)
+{
+    struct WorkArray* array = malloc(sizeof(struct WorkArray) + size * sizeof(_Atomic(void*)));
+    assert(array!=0);
+    array->size = size;
+    array->older = 0;
+    return array;
+}
+
+/*********************************************************************
+** Function: growArray
+**
+** Description: moves the items between top and bottom into a ring
+**              twice as large and publishes it
+**
+** Parameters:  a WorkDeque, its current array, bottom and top
+**
+** Pre-Conditions:  called by the owner while the array is full
+** Post-Conditions: returns the new array
+********************************************************************/
+static struct WorkArray* growArray(struct WorkDeque* deque, struct WorkArray* array,
+                                   long bottom, long top)
+{
+    struct WorkArray* bigger = createArray(array->size * 2);
+    for(long i = top; i < bottom; i++){
+        void* item = atomic_load_explicit(&array->items[i & (array->size - 1)], memory_order_relaxed);
+        atomic_store_explicit(&bigger->items[i & (bigger->size - 1)], item, memory_order_relaxed);
+    }
+    bigger->older = array;
+    atomic_store_explicit(&deque->array, bigger, memory_order_release);
+    return bigger;
+}
+
+/*********************************************************************
+** Function: workDequeCreate
+**
+** Description: allocates an empty deque with room for capacity items
+**              before it first grows
+**
+** Parameters:  the initial capacity
+**
+** Pre-Conditions:  capacity is positive
+** Post-Conditions: returns an empty deque
+********************************************************************/
+struct WorkDeque* workDequeCreate(int capacity)
+{
+    assert(capacity>0);
+
+    long size = 2;
+    while(size < capacity) size *= 2;
+
+    struct WorkDeque* deque = aligned_alloc(CACHE_LINE, sizeof(struct WorkDeque));
+    assert(deque!=0);
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->array, createArray(size));
+    return deque;
+}
+
+/*********************************************************************
+** Function: workDequeDestroy
+**
+** Description: frees the deque and every array it has used, the items
+**              themselves are not freed
+**
+** Parameters:  a WorkDeque
+**
+** Pre-Conditions:  no thread is using the deque
+** Post-Conditions: the deque has been freed
+********************************************************************/
+void workDequeDestroy(struct WorkDeque* deque)
+{
+    assert(deque!=0);
+    struct WorkArray* array = atomic_load(&deque->array);
+    while(array!=0){
+        struct WorkArray* older = array->older;
+        free(array);
+        array = older;
+    }
+    free(deque);
+}
+
+/*********************************************************************
+** Function: workDequePushBack
+**
+** Description: pushes an item on the owner's end of the deque
+**
+** Parameters:  a WorkDeque and item
+**
+** Pre-Conditions:  called by the owner, item is not null
+** Post-Conditions: the item is at the back
+********************************************************************/
+void workDequePushBack(struct WorkDeque* deque, void* item)
+{
+    assert(deque!=0 && item!=0);
+
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    struct WorkArray* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+    if(bottom - top > array->size - 1){
+        array = growArray(deque, array, bottom, top);
+    }
+    atomic_store_explicit(&array->items[bottom & (array->size - 1)], item, memory_order_relaxed);
+
+    // the item must be visible before a thief can see the new bottom
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+}
+
+/*********************************************************************
+** Function: workDequePopBack
+**
+** Description: pops the item most recently pushed by the owner
+**
+** Parameters:  a WorkDeque
+**
+** Pre-Conditions:  called by the owner
+** Post-Conditions: returns the item, or null if the deque was empty or
+**                  a thief took the last item
+********************************************************************/
+void* workDequePopBack(struct WorkDeque* deque)
+{
+    assert(deque!=0);
+
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    struct WorkArray* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+    // claim the back slot before looking at top
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    void* item = 0;
+    if(top <= bottom){
+        item = atomic_load_explicit(&array->items[bottom & (array->size - 1)], memory_order_relaxed);
+        if(top == bottom){
+            // last item, race the thieves for it
+            if(!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                        memory_order_seq_cst, memory_order_relaxed)){
+                item = 0;
+            }
+            atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        }
+    }
+    else {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+    return item;
+}
+
+/*********************************************************************
+** Function: workDequeStealFront
+**
+** Description: takes the oldest item from the deque
+**
+** Parameters:  a WorkDeque
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: returns the item, or null if the deque was empty or
+**                  another thread won the race for it
+********************************************************************/
+void* workDequeStealFront(struct WorkDeque* deque)
+{
+    assert(deque!=0);
+
+    long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if(top >= bottom) return 0;
+
+    struct WorkArray* array = atomic_load_explicit(&deque->array, memory_order_acquire);
+    void* item = atomic_load_explicit(&array->items[top & (array->size - 1)], memory_order_relaxed);
+    if(!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                memory_order_seq_cst, memory_order_relaxed)){
+        return 0;
+    }
+    return item;
+}
+
+/*********************************************************************
+** Function: workDequeIsEmpty
+**
+** Description: returns 1 if the deque looks empty and 0 if not, only a
+**              snapshot while other threads are using it
+**
+** Parameters:  a WorkDeque
+**
+** Pre-Conditions:  NONE
+** Post-Conditions: NONE
+********************************************************************/
+int workDequeIsEmpty(struct WorkDeque* deque)
+{
+    assert(deque!=0);
+    long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    return bottom <= top;
+}
@@ -0,0 +1,19 @@
+#ifndef WORK_DEQUE_H
+#define WORK_DEQUE_H
+
+struct WorkDeque;
+
+struct WorkDeque* workDequeCreate(int capacity);
+void workDequeDestroy(struct WorkDeque* deque);
+
+// Owner interface, only the thread that owns the deque may call these
+
+void workDequePushBack(struct WorkDeque* deque, void* item);
+void* workDequePopBack(struct WorkDeque* deque);
+
+// Thief interface, any thread may call these at any time
+
+void* workDequeStealFront(struct WorkDeque* deque);
+int workDequeIsEmpty(struct WorkDeque* deque);
+
+#endif
@@ -0,0 +1,207 @@
+//
+//  avlArena.c
+//  Worksheets_AVL_Heaps
+//
+
+#include <stdlib.h>
+#include <assert.h>
+#include "avlArena.h"
+
+// Same algorithm as worksheet_31.c, but every helper takes the arena and
+// an index. The arena may move when it grows, so no helper holds on to a
+// node pointer across a call that can allocate.
+
+static void _arenaSetHeight(struct AVLarenaNode * nodes, uint32_t current){
+    uint8_t lch = nodes[nodes[current].left].height;
+    uint8_t rch = nodes[nodes[current].right].height;
+    nodes[current].height = 1 + (lch < rch ? rch : lch);
+}
+
+
+static int _arenaBf(struct AVLarenaNode * nodes, uint32_t current){
+    return nodes[nodes[current].right].height - nodes[nodes[current].left].height;
+}
+
+
+static uint32_t _arenaRotateLeft(struct AVLarenaNode * nodes, uint32_t current){
+    uint32_t newTop = nodes[current].right;
+    nodes[current].right = nodes[newTop].left;
+    nodes[newTop].left = current;
+    _arenaSetHeight(nodes, current);
+    _arenaSetHeight(nodes, newTop);
+    return newTop;
+}
+
+
+static uint32_t _arenaRotateRight(struct AVLarenaNode * nodes, uint32_t current){
+    uint32_t newTop = nodes[current].left;
+    nodes[current].left = nodes[newTop].right;
+    nodes[newTop].right = current;
+    _arenaSetHeight(nodes, current);
+    _arenaSetHeight(nodes, newTop);
+    return newTop;
+}
+
+
+static uint32_t _arenaBalance(struct AVLarenaNode * nodes, uint32_t current){
+    int cbf = _arenaBf(nodes, current);
+    if(cbf < -1){
+        if(_arenaBf(nodes, nodes[current].left) > 0){
+            nodes[current].left = _arenaRotateLeft(nodes, nodes[current].left);
+        }
+        return _arenaRotateRight(nodes, current);
+    }
+    else if(cbf > 1){
+        if(_arenaBf(nodes, nodes[current].right) < 0){
+            nodes[current].right = _arenaRotateRight(nodes, nodes[current].right);
+        }
+        return _arenaRotateLeft(nodes, current);
+    }
+    _arenaSetHeight(nodes, current);
+    return current;
+}
+
+
+static void _arenaReserve(struct AVLarena * tree, uint32_t extra){
+    assert(extra <= UINT32_MAX - tree->count);
+    if(tree->count + extra <= tree->capacity) return;
+    while(tree->count + extra > tree->capacity){
+        tree->capacity = tree->capacity > UINT32_MAX / 2 ? UINT32_MAX : tree->capacity * 2;
+    }
+    tree->nodes = realloc(tree->nodes, tree->capacity * sizeof(struct AVLarenaNode));
+    assert(tree->nodes != 0);
+}
+
+
+// Takes the next slot, nodes are laid out in the order they were added
+static uint32_t _arenaNewNode(struct AVLarena * tree, TYPE newValue){
+    _arenaReserve(tree, 1);
+    uint32_t index = tree->count++;
+    tree->nodes[index].value = newValue;
+    tree->nodes[index].left = tree->nodes[index].right = AVL_NIL;
+    tree->nodes[index].height = 1;
+    return index;
+}
+
+
+static uint32_t _arenaBuildRange(struct AVLarena * tree, TYPE * values, uint32_t low, uint32_t high){
+    if(low == high) return AVL_NIL;
+    uint32_t mid = low + (high - low) / 2;
+    uint32_t current = _arenaNewNode(tree, values[mid]);
+    uint32_t left = _arenaBuildRange(tree, values, low, mid);
+    uint32_t right = _arenaBuildRange(tree, values, mid + 1, high);
+    tree->nodes[current].left = left;
+    tree->nodes[current].right = right;
+    _arenaSetHeight(tree->nodes, current);
+    return current;
+}
+
+
+struct AVLarena * AVLarenaCreate(uint32_t capacity){
+    struct AVLarena * tree = malloc(sizeof(struct AVLarena));
+    assert(tree != 0);
+    tree->capacity = capacity < 16 ? 16 : capacity + 1;
+    tree->nodes = malloc(tree->capacity * sizeof(struct AVLarenaNode));
+    assert(tree->nodes != 0);
+
+    // slot 0 stands in for every null child
+    tree->nodes[AVL_NIL].left = tree->nodes[AVL_NIL].right = AVL_NIL;
+    tree->nodes[AVL_NIL].height = 0;
+    tree->count = 1;
+    tree->root = AVL_NIL;
+    return tree;
+}
+
+
+// One free for the whole tree, however many nodes it has
+void AVLarenaDestroy(struct AVLarena * tree){
+    assert(tree != 0);
+    free(tree->nodes);
+    free(tree);
+}
+
+
+// Empties the tree but keeps the arena for reuse
+void AVLarenaClear(struct AVLarena * tree){
+    assert(tree != 0);
+    tree->count = 1;
+    tree->root = AVL_NIL;
+}
+
+
+// Iterative like _AVLnodeAdd: remember the path, then rebalance upwards
+// until a subtree keeps its old height
+void AVLarenaAdd(struct AVLarena * tree, TYPE newValue){
+    assert(tree != 0);
+    uint32_t path[AVL_MAX_HEIGHT];
+    uint8_t wentLeft[AVL_MAX_HEIGHT];
+    int depth = 0;
+
+    uint32_t current = tree->root;
+    while(current != AVL_NIL){
+        assert(depth < AVL_MAX_HEIGHT);
+        path[depth] = current;
+        wentLeft[depth] = newValue < tree->nodes[current].value;
+        current = wentLeft[depth] ? tree->nodes[current].left : tree->nodes[current].right;
+        depth++;
+    }
+
+    // allocating may move the arena, indices stay valid
+    uint32_t child = _arenaNewNode(tree, newValue);
+    struct AVLarenaNode * nodes = tree->nodes;
+
+    while(depth > 0){
+        depth--;
+        current = path[depth];
+        if(wentLeft[depth]) nodes[current].left = child;
+        else nodes[current].right = child;
+
+        uint8_t oldHeight = nodes[current].height;
+        child = _arenaBalance(nodes, current);
+        if(nodes[child].height == oldHeight){
+            // the rest of the path is unchanged apart from this link
+            if(depth == 0) tree->root = child;
+            else if(wentLeft[depth - 1]) nodes[path[depth - 1]].left = child;
+            else nodes[path[depth - 1]].right = child;
+            return;
+        }
+    }
+    tree->root = child;
+}
+
+
+// Replaces the tree with one built from count sorted values in O(n), laid
+// out in pre-order so a search walks forward through the arena
+void AVLarenaBuildSorted(struct AVLarena * tree, TYPE * values, uint32_t count){
+    assert(tree != 0);
+    assert(count == 0 || values != 0);
+    for(uint32_t i = 1; i < count; i++) assert(!(values[i] < values[i - 1]));
+
+    AVLarenaClear(tree);
+    _arenaReserve(tree, count);
+    tree->root = _arenaBuildRange(tree, values, 0, count);
+}
+
+
+int AVLarenaContains(struct AVLarena * tree, TYPE value){
+    assert(tree != 0);
+    struct AVLarenaNode * nodes = tree->nodes;
+    uint32_t current = tree->root;
+    while(current != AVL_NIL){
+        if(value == nodes[current].value) return 1;
+        current = value < nodes[current].value ? nodes[current].left : nodes[current].right;
+    }
+    return 0;
+}
+
+
+uint32_t AVLarenaSize(struct AVLarena * tree){
+    assert(tree != 0);
+    return tree->count - 1;
+}
+
+
+int AVLarenaHeight(struct AVLarena * tree){
+    assert(tree != 0);
+    return tree->nodes[tree->root].height;
+}
@@ -0,0 +1,51 @@
+//
+//  avlArena.h
+//  Worksheets_AVL_Heaps
+//
+//  AVL tree whose nodes live in one growable array and link to
+//  their children by 32-bit index instead of by pointer.
+//
+
+#ifndef avlArena_h
+#define avlArena_h
+
+#ifndef TYPE
+#define TYPE  int
+#endif
+
+#include <stdint.h>
+
+#ifndef AVL_MAX_HEIGHT
+#define AVL_MAX_HEIGHT 64
+#endif
+
+// Index 0 is the null child, slot 0 of the arena is never a real node
+#define AVL_NIL 0
+
+// 16 bytes for int keys, a struct AVLnode is 32 plus malloc's header.
+// height counts levels (a leaf is 1) so the null slot's height is 0.
+struct AVLarenaNode {
+    TYPE value;
+    uint32_t left;
+    uint32_t right;
+    uint8_t height;
+};
+
+struct AVLarena {
+    struct AVLarenaNode *nodes;
+    uint32_t count;         // slots in use, including slot 0
+    uint32_t capacity;
+    uint32_t root;
+};
+
+struct AVLarena * AVLarenaCreate(uint32_t capacity);
+void AVLarenaDestroy(struct AVLarena * tree);
+void AVLarenaClear(struct AVLarena * tree);
+
+void AVLarenaAdd(struct AVLarena * tree, TYPE newValue);
+void AVLarenaBuildSorted(struct AVLarena * tree, TYPE * values, uint32_t count);
+int AVLarenaContains(struct AVLarena * tree, TYPE value);
+uint32_t AVLarenaSize(struct AVLarena * tree);
+int AVLarenaHeight(struct AVLarena * tree);
+
+#endif /* avlArena_h */
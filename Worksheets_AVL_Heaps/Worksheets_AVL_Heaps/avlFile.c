@@ -0,0 +1,87 @@
+//
+//  avlFile.c
+//  Worksheets_AVL_Heaps
+//
+
+#include "avlFile.h"
+
+#define AVL_FILE_MAGIC "CS261AV"
+
+static const struct SnapshotFormat _format = { AVL_FILE_MAGIC, AVL_FILE_VERSION, sizeof(TYPE) };
+
+// Streams the tree out in order with an explicit stack
+static void _writeTree(struct SnapshotWriter * writer, void * arg){
+    struct AVLnode * stack[AVL_MAX_HEIGHT];
+    int depth = 0;
+    struct AVLnode * current = arg;
+    while(current != 0 || depth > 0){
+        for(; current != 0; current = current->left){
+            assert(depth < AVL_MAX_HEIGHT);
+            stack[depth++] = current;
+        }
+        current = stack[--depth];
+        if(!snapshotWrite(writer, &current->value)) return;
+        current = current->right;
+    }
+}
+
+// Replaces any file at path only once the new one is complete
+int AVLfileSave(struct AVLnode * root, const char * path){
+    assert(path != 0);
+    return snapshotFileSave(path, &_format, _writeTree, root);
+}
+
+int AVLfileOpen(const char * path, struct AVLfile * file){
+    assert(path != 0 && file != 0);
+    if(snapshotFileOpen(path, &_format, &file->file) != 0) return -1;
+    file->values = file->file.values;
+    file->count = file->file.count;
+    return 0;
+}
+
+// Trees, arenas and snapshots built from the file outlive it
+void AVLfileClose(struct AVLfile * file){
+    assert(file != 0);
+    snapshotFileClose(&file->file);
+    file->values = 0;
+    file->count = 0;
+}
+
+// Binary search of the mapped values, nothing is copied
+int AVLfileLowerBound(struct AVLfile * file, TYPE value, TYPE * found){
+    assert(file != 0 && file->file.map != 0);
+    int low = 0, high = file->count;
+    while(low < high){
+        int mid = low + (high - low) / 2;
+        if(file->values[mid] < value) low = mid + 1;
+        else high = mid;
+    }
+    if(low == file->count) return 0;
+    if(found != 0) *found = file->values[low];
+    return 1;
+}
+
+int AVLfileContains(struct AVLfile * file, TYPE value){
+    TYPE found;
+    return AVLfileLowerBound(file, value, &found) && !(value < found);
+}
+
+// The builders only read the values, the casts drop const for their
+// TYPE * parameters
+
+// One malloc per node, like every other AVLnode tree
+struct AVLnode * AVLfileTree(struct AVLfile * file){
+    assert(file != 0 && file->file.map != 0);
+    return _AVLbuildSorted((TYPE *)file->values, file->count);
+}
+
+// Replaces the arena's contents, its node array grows at most once
+void AVLfileArena(struct AVLfile * file, struct AVLarena * arena){
+    assert(file != 0 && file->file.map != 0);
+    AVLarenaBuildSorted(arena, (TYPE *)file->values, (uint32_t)file->count);
+}
+
+struct AVLsnapshot * AVLfileSnapshot(struct AVLfile * file){
+    assert(file != 0 && file->file.map != 0);
+    return AVLsnapshotCreateSorted((TYPE *)file->values, file->count);
+}
@@ -0,0 +1,40 @@
+//
+//  avlFile.h
+//  Worksheets_AVL_Heaps
+//
+//  Binary snapshot files of an AVL tree, in the snapshotFile.h format
+//  with the values in sorted order. An open file is mapped read-only
+//  and can be searched in place, or rebuilt into a tree, arena or
+//  Eytzinger snapshot without re-inserting value by value.
+//
+
+#ifndef avlFile_h
+#define avlFile_h
+
+#include "worksheet_31.h"
+#include "avlArena.h"
+#include "avlSnapshot.h"
+#include "snapshotFile.h"
+
+#define AVL_FILE_VERSION 1
+
+struct AVLfile {
+    const TYPE *values;     // sorted, values[0 .. count-1]
+    int count;
+    struct SnapshotFile file;
+};
+
+// Both return 0 on success or -1 with errno set, EINVAL for a file that
+// is not a snapshot of this TYPE
+int AVLfileSave(struct AVLnode * root, const char * path);
+int AVLfileOpen(const char * path, struct AVLfile * file);
+void AVLfileClose(struct AVLfile * file);
+
+int AVLfileContains(struct AVLfile * file, TYPE value);
+int AVLfileLowerBound(struct AVLfile * file, TYPE value, TYPE * found);
+
+struct AVLnode * AVLfileTree(struct AVLfile * file);
+void AVLfileArena(struct AVLfile * file, struct AVLarena * arena);
+struct AVLsnapshot * AVLfileSnapshot(struct AVLfile * file);
+
+#endif /* avlFile_h */
@@ -0,0 +1,176 @@
+//
+//  avlPersistent.c
+//  Worksheets_AVL_Heaps
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include "avlPersistent.h"
+
+#define CACHE_LINE 64
+
+// A reader's epoch is 0 while it is outside a read, the global epoch
+// starts at 1 so the two never mix up
+struct _readerSlot {
+    _Alignas(CACHE_LINE) atomic_ulong epoch;
+    atomic_int joined;
+};
+
+// Nodes replaced during some epoch, kept until every reader has moved on
+struct _retired {
+    struct AVLnode ** nodes;
+    int count;
+    int capacity;
+};
+
+struct AVLpersistent {
+    _Atomic(struct AVLnode *) root;
+    atomic_ulong epoch;
+    struct _retired retired[3];     // by epoch % 3, written by the writer only
+    struct _readerSlot readers[AVL_MAX_READERS];
+};
+
+
+struct AVLpersistent * AVLpersistentCreate(void){
+    struct AVLpersistent * tree = aligned_alloc(CACHE_LINE, sizeof(struct AVLpersistent));
+    assert(tree != 0);
+    atomic_init(&tree->root, 0);
+    atomic_init(&tree->epoch, 1);
+    memset(tree->retired, 0, sizeof(tree->retired));
+    for(int i = 0; i < AVL_MAX_READERS; i++){
+        atomic_init(&tree->readers[i].epoch, 0);
+        atomic_init(&tree->readers[i].joined, 0);
+    }
+    return tree;
+}
+
+
+static void _freeRetired(struct _retired * list){
+    for(int i = 0; i < list->count; i++) free(list->nodes[i]);
+    list->count = 0;
+}
+
+
+// Every version shares its unchanged nodes with the next, so the current
+// tree plus the retired lists hold each node exactly once
+void AVLpersistentDestroy(struct AVLpersistent * tree){
+    assert(tree != 0);
+    for(int i = 0; i < 3; i++){
+        _freeRetired(&tree->retired[i]);
+        free(tree->retired[i].nodes);
+    }
+    _AVLfree(atomic_load(&tree->root));
+    free(tree);
+}
+
+
+static void _retire(struct AVLpersistent * tree, struct AVLnode * node){
+    unsigned long epoch = atomic_load_explicit(&tree->epoch, memory_order_relaxed);
+    struct _retired * list = &tree->retired[epoch % 3];
+    if(list->count == list->capacity){
+        list->capacity = list->capacity == 0 ? 64 : list->capacity * 2;
+        list->nodes = realloc(list->nodes, list->capacity * sizeof(struct AVLnode *));
+        assert(list->nodes != 0);
+    }
+    list->nodes[list->count++] = node;
+}
+
+
+// Moves the epoch on if every reader inside a read has seen the current one.
+// Those readers entered after the last advance, so nothing retired two
+// epochs ago is reachable from the roots they hold and it can be freed.
+static void _collect(struct AVLpersistent * tree){
+    unsigned long epoch = atomic_load(&tree->epoch);
+    for(int i = 0; i < AVL_MAX_READERS; i++){
+        unsigned long seen = atomic_load(&tree->readers[i].epoch);
+        if(seen != 0 && seen != epoch) return;
+    }
+    _freeRetired(&tree->retired[(epoch + 1) % 3]);
+    atomic_store(&tree->epoch, epoch + 1);
+}
+
+
+static struct AVLnode * _copy(struct AVLpersistent * tree, struct AVLnode * node){
+    struct AVLnode * copy = malloc(sizeof(struct AVLnode));
+    assert(copy != 0);
+    *copy = *node;
+    _retire(tree, node);
+    return copy;
+}
+
+
+// Same climb as _AVLnodeAdd, but every node on the path is copied on the way
+// down first. An insert only ever rotates nodes on its own path, so _balance
+// and the rotations touch nothing but those copies and the published version
+// is never written.
+void AVLpersistentAdd(struct AVLpersistent * tree, TYPE newValue){
+    assert(tree != 0);
+    struct AVLnode * root = atomic_load_explicit(&tree->root, memory_order_relaxed);
+
+    struct AVLnode ** path[AVL_MAX_HEIGHT];
+    int depth = 0;
+    struct AVLnode ** link = &root;
+    while(*link != 0){
+        assert(depth < AVL_MAX_HEIGHT);
+        struct AVLnode * copy = _copy(tree, *link);
+        copy->size++;
+        *link = copy;
+        path[depth++] = link;
+        if(newValue < copy->value) link = &copy->left;
+        else link = &copy->right;
+    }
+
+    struct AVLnode * newnode = malloc(sizeof(struct AVLnode));
+    assert(newnode != 0);
+    newnode->value = newValue;
+    newnode->left = newnode->right = 0;
+    newnode->height = 0;
+    newnode->size = 1;
+    *link = newnode;
+
+    while(depth > 0){
+        link = path[--depth];
+        int oldHeight = (*link)->height;
+        *link = _balance(*link);
+        if((*link)->height == oldHeight) break;
+    }
+
+    // every new node is written before a reader can reach it
+    atomic_store(&tree->root, root);
+    _collect(tree);
+}
+
+
+int AVLpersistentJoin(struct AVLpersistent * tree){
+    assert(tree != 0);
+    for(int i = 0; i < AVL_MAX_READERS; i++){
+        int unused = 0;
+        if(atomic_compare_exchange_strong(&tree->readers[i].joined, &unused, 1)) return i;
+    }
+    assert(0 && "more than AVL_MAX_READERS readers");
+    return -1;
+}
+
+
+void AVLpersistentLeave(struct AVLpersistent * tree, int reader){
+    assert(tree != 0 && reader >= 0 && reader < AVL_MAX_READERS);
+    assert(atomic_load(&tree->readers[reader].epoch) == 0);
+    atomic_store(&tree->readers[reader].joined, 0);
+}
+
+
+// Never blocks or retries: announcing the epoch before loading the root is
+// what keeps the writer from freeing anything under that root
+struct AVLnode * AVLpersistentEnter(struct AVLpersistent * tree, int reader){
+    assert(tree != 0 && reader >= 0 && reader < AVL_MAX_READERS);
+    atomic_store(&tree->readers[reader].epoch, atomic_load(&tree->epoch));
+    return atomic_load(&tree->root);
+}
+
+
+void AVLpersistentExit(struct AVLpersistent * tree, int reader){
+    assert(tree != 0 && reader >= 0 && reader < AVL_MAX_READERS);
+    atomic_store_explicit(&tree->readers[reader].epoch, 0, memory_order_release);
+}
@@ -0,0 +1,39 @@
+//
+//  avlPersistent.h
+//  Worksheets_AVL_Heaps
+//
+//  Persistent AVL tree for one writer and many readers. An insert
+//  copies the path it changes and publishes a new root atomically,
+//  so a reader's version never changes under it. Replaced nodes are
+//  freed once no reader can still see them (epoch based reclamation).
+//
+
+#ifndef avlPersistent_h
+#define avlPersistent_h
+
+#include "worksheet_31.h"
+
+#ifndef AVL_MAX_READERS
+#define AVL_MAX_READERS 64
+#endif
+
+struct AVLpersistent;
+
+struct AVLpersistent * AVLpersistentCreate(void);
+void AVLpersistentDestroy(struct AVLpersistent * tree);
+
+// Writer interface, one thread at a time
+
+void AVLpersistentAdd(struct AVLpersistent * tree, TYPE newValue);
+
+// Reader interface. A reader joins once to get a slot, then brackets each
+// read with enter and exit; between them the root it got and every node
+// under it stay valid and unchanged, and any of the read-only AVL
+// functions (_AVLfind, _AVLrange, _AVLrank, ...) may be used on it.
+
+int AVLpersistentJoin(struct AVLpersistent * tree);
+void AVLpersistentLeave(struct AVLpersistent * tree, int reader);
+struct AVLnode * AVLpersistentEnter(struct AVLpersistent * tree, int reader);
+void AVLpersistentExit(struct AVLpersistent * tree, int reader);
+
+#endif /* avlPersistent_h */
@@ -0,0 +1,123 @@
+//
+//  avlSnapshot.c
+//  Worksheets_AVL_Heaps
+//
+
+#include <stdlib.h>
+#include <assert.h>
+#include "avlSnapshot.h"
+
+#define CACHE_LINE 64
+
+// Keys per cache line; keys[k * KEYS_PER_LINE] is the line holding the
+// 16 (for int) descendants of k four levels down
+#define KEYS_PER_LINE (CACHE_LINE / sizeof(TYPE))
+
+// Hands out the tree's values in order, one per call
+struct _inorder {
+    struct AVLnode * stack[AVL_MAX_HEIGHT];
+    int depth;
+    TYPE * values;
+};
+
+static TYPE _next(struct _inorder * walk){
+    if(walk->values != 0) return *walk->values++;
+
+    struct AVLnode * current = walk->stack[--walk->depth];
+    TYPE value = current->value;
+    for(current = current->right; current != 0; current = current->left){
+        walk->stack[walk->depth++] = current;
+    }
+    return value;
+}
+
+
+// Visiting the implicit tree in order hands out the sorted values in order,
+// so keys ends up sorted along every root to leaf path
+static void _fill(struct AVLsnapshot * snapshot, struct _inorder * walk, int k){
+    if(k > snapshot->count) return;
+    _fill(snapshot, walk, 2 * k);
+    snapshot->keys[k] = _next(walk);
+    _fill(snapshot, walk, 2 * k + 1);
+}
+
+
+static struct AVLsnapshot * _create(int count, struct _inorder * walk){
+    struct AVLsnapshot * snapshot = malloc(sizeof(struct AVLsnapshot));
+    assert(snapshot != 0);
+    snapshot->count = count;
+
+    // keys[0] starts a line, so each group of 16 siblings shares one line
+    void * keys = 0;
+    int failed = posix_memalign(&keys, CACHE_LINE, (count + 1) * sizeof(TYPE));
+    assert(failed == 0 && keys != 0);
+    snapshot->keys = keys;
+
+    _fill(snapshot, walk, 1);
+    return snapshot;
+}
+
+
+// Copies the tree, later changes to the tree do not show in the snapshot
+struct AVLsnapshot * AVLsnapshotCreate(struct AVLnode * root){
+    struct _inorder walk;
+    walk.depth = 0;
+    walk.values = 0;
+    for(struct AVLnode * current = root; current != 0; current = current->left){
+        walk.stack[walk.depth++] = current;
+    }
+    return _create(_sz(root), &walk);
+}
+
+
+struct AVLsnapshot * AVLsnapshotCreateSorted(TYPE * values, int count){
+    assert(count == 0 || values != 0);
+    struct _inorder walk;
+    walk.depth = 0;
+    walk.values = values;
+    return _create(count, &walk);
+}
+
+
+void AVLsnapshotDestroy(struct AVLsnapshot * snapshot){
+    assert(snapshot != 0);
+    free(snapshot->keys);
+    free(snapshot);
+}
+
+
+// Eytzinger index of the first key not less than value, 0 if there is none.
+// The step down is a compare and an add, never a branch on the key, and the
+// line four levels below is requested while this level is compared. Near the
+// leaves that line is past the end of keys, which a prefetch ignores.
+static int _search(struct AVLsnapshot * snapshot, TYPE value){
+    TYPE * keys = snapshot->keys;
+    int n = snapshot->count;
+    unsigned int k = 1;
+    while(k <= (unsigned int)n){
+        __builtin_prefetch(keys + k * KEYS_PER_LINE);
+        k = 2 * k + (keys[k] < value);
+    }
+    // every right turn taken after the last left turn went past value,
+    // so drop them and the final left turn to get back to the answer
+    k >>= __builtin_ffs(~k);
+    return (int)k;
+}
+
+
+int AVLsnapshotContains(struct AVLsnapshot * snapshot, TYPE value){
+    assert(snapshot != 0);
+    int k = _search(snapshot, value);
+    return k != 0 && !(value < snapshot->keys[k]);
+}
+
+
+// Stores the smallest key not less than value in found and returns 1, or
+// returns 0 if every key is less than value
+int AVLsnapshotLowerBound(struct AVLsnapshot * snapshot, TYPE value, TYPE * found){
+    assert(snapshot != 0 && found != 0);
+    int k = _search(snapshot, value);
+    if(k == 0) return 0;
+    *found = snapshot->keys[k];
+    return 1;
+}
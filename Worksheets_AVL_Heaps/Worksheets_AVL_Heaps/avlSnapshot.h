@@ -0,0 +1,27 @@
+//
+//  avlSnapshot.h
+//  Worksheets_AVL_Heaps
+//
+//  Read-only copy of an AVL tree in Eytzinger (breadth-first) order:
+//  the children of keys[k] are keys[2k] and keys[2k+1], so a search
+//  walks one flat, cache-line-aligned array with no pointers.
+//
+
+#ifndef avlSnapshot_h
+#define avlSnapshot_h
+
+#include "worksheet_31.h"
+
+struct AVLsnapshot {
+    TYPE *keys;     // keys[1..count], keys[0] is unused
+    int count;
+};
+
+struct AVLsnapshot * AVLsnapshotCreate(struct AVLnode * root);
+struct AVLsnapshot * AVLsnapshotCreateSorted(TYPE * values, int count);
+void AVLsnapshotDestroy(struct AVLsnapshot * snapshot);
+
+int AVLsnapshotContains(struct AVLsnapshot * snapshot, TYPE value);
+int AVLsnapshotLowerBound(struct AVLsnapshot * snapshot, TYPE value, TYPE * found);
+
+#endif /* avlSnapshot_h */
@@ -0,0 +1,240 @@
+//
+//  avlTemplate.h
+//  Worksheets_AVL_Heaps
+//
+//  Generates an AVL tree for one value type, so trees of several types
+//  can live in one program without the global TYPE macro. Define
+//  AVL_NAME and AVL_TYPE, and AVL_LT if < does not fit, then include
+//  this file, once for every type:
+//
+//      #define AVL_NAME AVL_f64
+//      #define AVL_TYPE double
+//      #include "avlTemplate.h"
+//
+//  gives struct AVL_f64 and AVL_f64_add, AVL_f64_contains and so on.
+//  Every function is static inline so callers in any file can inline
+//  them. Heights and balancing follow worksheet_31.c.
+//
+
+#include <stdlib.h>
+#include <assert.h>
+
+#if !defined(AVL_NAME) || !defined(AVL_TYPE)
+#error "define AVL_NAME and AVL_TYPE before including avlTemplate.h"
+#endif
+
+#ifndef AVL_LT
+#define AVL_LT(A, B) ((A) < (B))
+#endif
+
+#ifndef AVL_MAX_HEIGHT
+#define AVL_MAX_HEIGHT 64
+#endif
+
+#define AVL_JOIN2(A, B) A##_##B
+#define AVL_JOIN(A, B) AVL_JOIN2(A, B)
+#define AVL_FN(NAME) AVL_JOIN(AVL_NAME, NAME)
+#define AVL_NODE AVL_JOIN(AVL_NAME, node)
+
+struct AVL_NODE {
+    AVL_TYPE value;
+    struct AVL_NODE *left;
+    struct AVL_NODE *right;
+    int height;     // a leaf is 0, as in worksheet_31.c
+};
+
+struct AVL_NAME {
+    struct AVL_NODE *root;
+    int size;
+};
+
+static inline void AVL_FN(init)(struct AVL_NAME * tree){
+    assert(tree != 0);
+    tree->root = 0;
+    tree->size = 0;
+}
+
+static inline void AVL_FN(freeNodes)(struct AVL_NODE * current){
+    // recursion depth is bounded by the height
+    if(current == 0) return;
+    AVL_FN(freeNodes)(current->left);
+    AVL_FN(freeNodes)(current->right);
+    free(current);
+}
+
+// Frees every node but not the tree itself
+static inline void AVL_FN(cleanup)(struct AVL_NAME * tree){
+    assert(tree != 0);
+    AVL_FN(freeNodes)(tree->root);
+    tree->root = 0;
+    tree->size = 0;
+}
+
+static inline struct AVL_NAME * AVL_FN(create)(void){
+    struct AVL_NAME * tree = malloc(sizeof(struct AVL_NAME));
+    assert(tree != 0);
+    AVL_FN(init)(tree);
+    return tree;
+}
+
+static inline void AVL_FN(destroy)(struct AVL_NAME * tree){
+    AVL_FN(cleanup)(tree);
+    free(tree);
+}
+
+static inline int AVL_FN(size)(struct AVL_NAME * tree){
+    assert(tree != 0);
+    return tree->size;
+}
+
+static inline int AVL_FN(h)(struct AVL_NODE * current){
+    return current == 0 ? -1 : current->height;
+}
+
+static inline void AVL_FN(setHeight)(struct AVL_NODE * current){
+    int lh = AVL_FN(h)(current->left);
+    int rh = AVL_FN(h)(current->right);
+    current->height = 1 + (lh < rh ? rh : lh);
+}
+
+static inline struct AVL_NODE * AVL_FN(rotateLeft)(struct AVL_NODE * current){
+    struct AVL_NODE * newTop = current->right;
+    current->right = newTop->left;
+    newTop->left = current;
+    AVL_FN(setHeight)(current);
+    AVL_FN(setHeight)(newTop);
+    return newTop;
+}
+
+static inline struct AVL_NODE * AVL_FN(rotateRight)(struct AVL_NODE * current){
+    struct AVL_NODE * newTop = current->left;
+    current->left = newTop->right;
+    newTop->right = current;
+    AVL_FN(setHeight)(current);
+    AVL_FN(setHeight)(newTop);
+    return newTop;
+}
+
+static inline struct AVL_NODE * AVL_FN(balance)(struct AVL_NODE * current){
+    int cbf = AVL_FN(h)(current->right) - AVL_FN(h)(current->left);
+    if(cbf < -1){
+        struct AVL_NODE * left = current->left;
+        if(AVL_FN(h)(left->right) > AVL_FN(h)(left->left)){
+            current->left = AVL_FN(rotateLeft)(left);
+        }
+        return AVL_FN(rotateRight)(current);
+    }
+    else if(cbf > 1){
+        struct AVL_NODE * right = current->right;
+        if(AVL_FN(h)(right->left) > AVL_FN(h)(right->right)){
+            current->right = AVL_FN(rotateRight)(right);
+        }
+        return AVL_FN(rotateLeft)(current);
+    }
+    AVL_FN(setHeight)(current);
+    return current;
+}
+
+// Adds a value, equal values go right; iterative like _AVLnodeAdd
+static inline void AVL_FN(add)(struct AVL_NAME * tree, AVL_TYPE value){
+    assert(tree != 0);
+    struct AVL_NODE ** path[AVL_MAX_HEIGHT];
+    int depth = 0;
+    struct AVL_NODE ** link = &tree->root;
+    while(*link != 0){
+        assert(depth < AVL_MAX_HEIGHT);
+        path[depth++] = link;
+        if(AVL_LT(value, (*link)->value)) link = &(*link)->left;
+        else link = &(*link)->right;
+    }
+    struct AVL_NODE * newNode = malloc(sizeof(struct AVL_NODE));
+    assert(newNode != 0);
+    newNode->value = value;
+    newNode->left = newNode->right = 0;
+    newNode->height = 0;
+    *link = newNode;
+    tree->size++;
+
+    // stop climbing once a subtree's height is unchanged
+    while(depth > 0){
+        link = path[--depth];
+        int oldHeight = (*link)->height;
+        *link = AVL_FN(balance)(*link);
+        if((*link)->height == oldHeight) break;
+    }
+}
+
+static inline int AVL_FN(contains)(struct AVL_NAME * tree, AVL_TYPE value){
+    assert(tree != 0);
+    struct AVL_NODE * current = tree->root;
+    while(current != 0){
+        if(AVL_LT(value, current->value)) current = current->left;
+        else if(AVL_LT(current->value, value)) current = current->right;
+        else return 1;
+    }
+    return 0;
+}
+
+// Removes one node equal to value, returns 1 if there was one
+static inline int AVL_FN(remove)(struct AVL_NAME * tree, AVL_TYPE value){
+    assert(tree != 0);
+    struct AVL_NODE ** path[AVL_MAX_HEIGHT];
+    int depth = 0;
+    struct AVL_NODE ** link = &tree->root;
+    while(*link != 0 && (AVL_LT((*link)->value, value) || AVL_LT(value, (*link)->value))){
+        assert(depth < AVL_MAX_HEIGHT);
+        path[depth++] = link;
+        if(AVL_LT(value, (*link)->value)) link = &(*link)->left;
+        else link = &(*link)->right;
+    }
+    if(*link == 0) return 0;
+
+    // a node with two children takes its successor's value instead
+    struct AVL_NODE * target = *link;
+    if(target->left != 0 && target->right != 0){
+        path[depth++] = link;
+        link = &target->right;
+        while((*link)->left != 0){
+            assert(depth < AVL_MAX_HEIGHT);
+            path[depth++] = link;
+            link = &(*link)->left;
+        }
+        target->value = (*link)->value;
+    }
+
+    struct AVL_NODE * gone = *link;
+    *link = gone->left != 0 ? gone->left : gone->right;
+    free(gone);
+    tree->size--;
+
+    while(depth > 0){
+        link = path[--depth];
+        int oldHeight = (*link)->height;
+        *link = AVL_FN(balance)(*link);
+        if((*link)->height == oldHeight) break;
+    }
+    return 1;
+}
+
+static inline AVL_TYPE AVL_FN(min)(struct AVL_NAME * tree){
+    assert(tree != 0 && tree->root != 0);
+    struct AVL_NODE * current = tree->root;
+    while(current->left != 0) current = current->left;
+    return current->value;
+}
+
+static inline AVL_TYPE AVL_FN(max)(struct AVL_NAME * tree){
+    assert(tree != 0 && tree->root != 0);
+    struct AVL_NODE * current = tree->root;
+    while(current->right != 0) current = current->right;
+    return current->value;
+}
+
+// ready for the next instantiation
+#undef AVL_NAME
+#undef AVL_TYPE
+#undef AVL_LT
+#undef AVL_JOIN2
+#undef AVL_JOIN
+#undef AVL_FN
+#undef AVL_NODE
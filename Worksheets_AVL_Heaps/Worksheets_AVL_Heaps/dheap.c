@@ -0,0 +1,176 @@
+//
+//  dheap.c
+//  Worksheets_AVL_Heaps
+//
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "dheap.h"
+
+#define CACHE_LINE 64
+
+// The children of position i are positions HEAP_ARITY * i + 1 through
+// HEAP_ARITY * i + HEAP_ARITY. Storing position i at i + HEAP_ARITY - 1
+// puts the first child at data[HEAP_ARITY * (i + 1)], so every group of
+// siblings starts on a multiple of the group size and, with data aligned
+// to a line, never straddles two lines.
+#define SLOT(heap, i) ((heap)->data[(size_t)(i) + HEAP_ARITY - 1])
+
+// Largest capacity whose slots, counting the HEAP_ARITY - 1 unused ones in
+// front, can still be indexed by an int
+#define MAX_CAPACITY (INT32_MAX - (HEAP_ARITY - 1))
+
+
+// realloc would lose the alignment, so growing copies into a new block
+static void _setCapacity(struct DHeap * heap, int capacity){
+    assert(capacity > 0 && capacity <= MAX_CAPACITY);
+    void * data = 0;
+    int failed = posix_memalign(&data, CACHE_LINE, ((size_t)capacity + HEAP_ARITY - 1) * sizeof(TYPE));
+    assert(failed == 0 && data != 0);
+    if(heap->data != 0){
+        if(heap->size > 0){
+            memcpy((TYPE *)data + HEAP_ARITY - 1, heap->data + HEAP_ARITY - 1, (size_t)heap->size * sizeof(TYPE));
+        }
+        free(heap->data);
+    }
+    heap->data = data;
+    heap->capacity = capacity;
+}
+
+
+static void _reserve(struct DHeap * heap, int extra){
+    assert(extra >= 0 && heap->size <= MAX_CAPACITY - extra);
+    if(heap->size + extra <= heap->capacity) return;
+    int capacity = heap->capacity;
+    while(capacity < heap->size + extra) capacity = capacity > MAX_CAPACITY / 2 ? MAX_CAPACITY : 2 * capacity;
+    _setCapacity(heap, capacity);
+}
+
+
+struct DHeap * dheapCreate(int capacity){
+    struct DHeap * heap = malloc(sizeof(struct DHeap));
+    assert(heap != 0);
+    heap->data = 0;
+    heap->size = 0;
+    _setCapacity(heap, capacity < 16 ? 16 : capacity > MAX_CAPACITY ? MAX_CAPACITY : capacity);
+    return heap;
+}
+
+
+void dheapDestroy(struct DHeap * heap){
+    assert(heap != 0);
+    free(heap->data);
+    free(heap);
+}
+
+
+int dheapSize(struct DHeap * heap){
+    assert(heap != 0);
+    return heap->size;
+}
+
+
+int dheapIsEmpty(struct DHeap * heap){
+    assert(heap != 0);
+    return heap->size == 0;
+}
+
+
+// Moves the hole at position i up until value fits, one write per level
+static void _siftUp(struct DHeap * heap, int i, TYPE value){
+    while(i > 0){
+        int parent = (i - 1) / HEAP_ARITY;
+        if(!LT(value, SLOT(heap, parent))) break;
+        SLOT(heap, i) = SLOT(heap, parent);
+        i = parent;
+    }
+    SLOT(heap, i) = value;
+}
+
+
+// Moves the hole at position i down until value fits. The smallest child is
+// found by scanning its group, which sits in one cache line; the scan keeps
+// the best child in registers so it compiles to conditional moves instead of
+// branches that random keys would mispredict. Positions are size_t here since
+// HEAP_ARITY * i + 1 overflows an int once i passes INT_MAX / HEAP_ARITY.
+static void _siftDown(struct DHeap * heap, int start, TYPE value){
+    size_t size = (size_t)heap->size;
+    size_t i = (size_t)start;
+    for(;;){
+        size_t first = HEAP_ARITY * i + 1;
+        if(first >= size) break;
+
+        size_t last = first + HEAP_ARITY < size ? first + HEAP_ARITY : size;
+        size_t smallest = first;
+        TYPE best = SLOT(heap, first);
+        for(size_t child = first + 1; child < last; child++){
+            TYPE candidate = SLOT(heap, child);
+            int less = LT(candidate, best);
+            best = less ? candidate : best;
+            smallest = less ? child : smallest;
+        }
+        if(!LT(best, value)) break;
+        SLOT(heap, i) = best;
+        i = smallest;
+    }
+    SLOT(heap, i) = value;
+}
+
+
+void dheapPush(struct DHeap * heap, TYPE value){
+    assert(heap != 0);
+    _reserve(heap, 1);
+    _siftUp(heap, heap->size++, value);
+}
+
+
+TYPE dheapPeek(struct DHeap * heap){
+    assert(heap != 0 && heap->size > 0);
+    return SLOT(heap, 0);
+}
+
+
+TYPE dheapPop(struct DHeap * heap){
+    assert(heap != 0 && heap->size > 0);
+    TYPE first = SLOT(heap, 0);
+    TYPE last = SLOT(heap, --heap->size);
+    if(heap->size > 0) _siftDown(heap, 0, last);
+    return first;
+}
+
+
+// Sifts every parent down, last first: O(n) for any arity
+static void _buildHeap(struct DHeap * heap){
+    for(int i = (heap->size - 2) / HEAP_ARITY; i >= 0 && heap->size > 1; i--){
+        _siftDown(heap, i, SLOT(heap, i));
+    }
+}
+
+
+// Replaces the contents of the heap with count values in O(count)
+void dheapHeapify(struct DHeap * heap, const TYPE * values, int count){
+    assert(heap != 0 && count >= 0 && (count == 0 || values != 0));
+    heap->size = 0;
+    _reserve(heap, count);
+    if(count > 0) memcpy(&SLOT(heap, 0), values, (size_t)count * sizeof(TYPE));
+    heap->size = count;
+    _buildHeap(heap);
+}
+
+
+// Adds count values. A batch larger than the heap is cheaper to rebuild
+// from scratch in O(n) than to sift up one value at a time.
+void dheapPushArray(struct DHeap * heap, const TYPE * values, int count){
+    assert(heap != 0 && count >= 0 && (count == 0 || values != 0));
+    _reserve(heap, count);
+    if(count > heap->size){
+        memcpy(&SLOT(heap, heap->size), values, (size_t)count * sizeof(TYPE));
+        heap->size += count;
+        _buildHeap(heap);
+    }
+    else {
+        for(int i = 0; i < count; i++) _siftUp(heap, heap->size++, values[i]);
+    }
+}
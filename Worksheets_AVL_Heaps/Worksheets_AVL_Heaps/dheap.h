@@ -0,0 +1,44 @@
+//
+//  dheap.h
+//  Worksheets_AVL_Heaps
+//
+//  Array-backed d-ary min heap. A wider node means a shallower heap and
+//  all HEAP_ARITY children of a node are compared from one cache line.
+//
+
+#ifndef dheap_h
+#define dheap_h
+
+#ifndef TYPE
+#define TYPE  int
+#endif
+
+#ifndef LT
+#define LT(A, B) ((A) < (B))
+#endif
+
+// Children per node, a power of two keeps each group inside one line as
+// long as HEAP_ARITY * sizeof(TYPE) is at most 64 bytes
+#ifndef HEAP_ARITY
+#define HEAP_ARITY 4
+#endif
+
+struct DHeap {
+    TYPE *data;     // heap position i is data[i + HEAP_ARITY - 1]
+    int size;
+    int capacity;
+};
+
+struct DHeap * dheapCreate(int capacity);
+void dheapDestroy(struct DHeap * heap);
+
+int dheapSize(struct DHeap * heap);
+int dheapIsEmpty(struct DHeap * heap);
+void dheapPush(struct DHeap * heap, TYPE value);
+TYPE dheapPeek(struct DHeap * heap);
+TYPE dheapPop(struct DHeap * heap);
+
+void dheapHeapify(struct DHeap * heap, const TYPE * values, int count);
+void dheapPushArray(struct DHeap * heap, const TYPE * values, int count);
+
+#endif /* dheap_h */
@@ -0,0 +1,155 @@
+//
+//  heapBench.c
+//  Worksheets_AVL_Heaps
+//
+//  Times the d-ary heap against a plain binary heap: heapify, push,
+//  pop and a mixed push/pop workload, at 10^6 to 10^8 elements.
+//  Not part of the Xcode target, it has its own main:
+//
+//      cc -O2 -std=gnu11 heapBench.c dheap.c -o heapBench
+//      ./heapBench [largest size, default 10000000]
+//
+//  Prints one CSV row per run.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include "dheap.h"
+
+// Textbook binary heap, position i has children 2i+1 and 2i+2
+struct BinaryHeap {
+    TYPE *data;
+    int size;
+};
+
+static void binaryPush(struct BinaryHeap * heap, TYPE value){
+    int i = heap->size++;
+    while(i > 0 && LT(value, heap->data[(i - 1) / 2])){
+        heap->data[i] = heap->data[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap->data[i] = value;
+}
+
+static void binarySiftDown(struct BinaryHeap * heap, int i, TYPE value){
+    for(;;){
+        int child = 2 * i + 1;
+        if(child >= heap->size) break;
+        if(child + 1 < heap->size && LT(heap->data[child + 1], heap->data[child])) child++;
+        if(!LT(heap->data[child], value)) break;
+        heap->data[i] = heap->data[child];
+        i = child;
+    }
+    heap->data[i] = value;
+}
+
+static TYPE binaryPop(struct BinaryHeap * heap){
+    TYPE first = heap->data[0];
+    TYPE last = heap->data[--heap->size];
+    if(heap->size > 0) binarySiftDown(heap, 0, last);
+    return first;
+}
+
+static void binaryHeapify(struct BinaryHeap * heap, const TYPE * values, int count){
+    for(int i = 0; i < count; i++) heap->data[i] = values[i];
+    heap->size = count;
+    for(int i = count / 2 - 1; i >= 0; i--) binarySiftDown(heap, i, heap->data[i]);
+}
+
+
+static double now(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void report(const char * heap, const char * operation, int elements, long ops, double seconds){
+    printf("%s,%s,%d,%ld,%.6f,%.2f,%.0f\n", heap, operation, elements, ops, seconds,
+           seconds * 1e9 / ops, ops / seconds);
+}
+
+static TYPE * randomValues(int count){
+    TYPE * values = malloc((size_t)count * sizeof(TYPE));
+    assert(values != 0);
+    unsigned long long state = 88172645463325252ull;
+    for(int i = 0; i < count; i++){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        values[i] = (TYPE)(state >> 33);
+    }
+    return values;
+}
+
+static void benchDHeap(const TYPE * values, int count){
+    char name[32];
+    snprintf(name, sizeof(name), "dheap%d", HEAP_ARITY);
+    struct DHeap * heap = dheapCreate(count);
+    long sum = 0;
+
+    double start = now();
+    dheapHeapify(heap, values, count);
+    report(name, "heapify", count, count, now() - start);
+
+    start = now();
+    for(int i = 0; i < count; i++){
+        sum += dheapPop(heap);
+        dheapPush(heap, values[i]);
+    }
+    report(name, "pop_push", count, 2L * count, now() - start);
+
+    start = now();
+    while(!dheapIsEmpty(heap)) sum += dheapPop(heap);
+    report(name, "pop", count, count, now() - start);
+
+    start = now();
+    for(int i = 0; i < count; i++) dheapPush(heap, values[i]);
+    report(name, "push", count, count, now() - start);
+
+    dheapDestroy(heap);
+    if(sum == 42) printf("\n");
+}
+
+static void benchBinary(const TYPE * values, int count){
+    struct BinaryHeap heap;
+    heap.data = malloc((size_t)count * sizeof(TYPE));
+    assert(heap.data != 0);
+    long sum = 0;
+
+    double start = now();
+    binaryHeapify(&heap, values, count);
+    report("binary", "heapify", count, count, now() - start);
+
+    start = now();
+    for(int i = 0; i < count; i++){
+        sum += binaryPop(&heap);
+        binaryPush(&heap, values[i]);
+    }
+    report("binary", "pop_push", count, 2L * count, now() - start);
+
+    start = now();
+    while(heap.size > 0) sum += binaryPop(&heap);
+    report("binary", "pop", count, count, now() - start);
+
+    start = now();
+    for(int i = 0; i < count; i++) binaryPush(&heap, values[i]);
+    report("binary", "push", count, count, now() - start);
+
+    free(heap.data);
+    if(sum == 42) printf("\n");
+}
+
+int main(int argc, const char * argv[]) {
+    int largest = argc > 1 ? atoi(argv[1]) : 10000000;
+
+    printf("heap,operation,elements,operations,seconds,ns_per_op,ops_per_sec\n");
+    for(int count = 1000000; count <= largest && count > 0; count = count > 0x7fffffff / 10 ? -1 : count * 10){
+        TYPE * values = randomValues(count);
+        benchBinary(values, count);
+        benchDHeap(values, count);
+        free(values);
+    }
+    return 0;
+}
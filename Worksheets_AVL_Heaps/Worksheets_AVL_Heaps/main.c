@@ -7,9 +7,264 @@
 //
 
 #include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "worksheet_31.h"
+#include "avlArena.h"
+#include "avlPersistent.h"
+#include "dheap.h"
+#include "avlFile.h"
+
+// a tree of doubles next to the TYPE tree
+#define AVL_NAME AVL_f64
+#define AVL_TYPE double
+#include "avlTemplate.h"
+
+#define KEYS 100000
+
+// the n-th key of the pseudo-random sequence every tree below is fed
+static TYPE _nextKey(unsigned int * key){
+    *key = *key * 1103515245u + 12345u;
+    return (TYPE)(*key >> 8);
+}
+
+
+static int _compare(const void * a, const void * b){
+    TYPE x = *(const TYPE *)a, y = *(const TYPE *)b;
+    return (y < x) - (x < y);
+}
+
+
+// Index of the first value in sorted that is not less than value, or
+// greater than value when after is set
+static int _search(TYPE * sorted, int count, TYPE value, int after){
+    int low = 0, high = count;
+    while(low < high){
+        int mid = low + (high - low) / 2;
+        if(sorted[mid] < value || (after && !(value < sorted[mid]))) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+
+// Pops the heap dry, the values must come out as sorted
+static void _checkHeap(struct DHeap * heap, TYPE * sorted, int count){
+    assert(dheapSize(heap) == count);
+    for(int i = 0; i < count; i++){
+        assert(dheapPeek(heap) == sorted[i]);
+        assert(dheapPop(heap) == sorted[i]);
+    }
+    assert(dheapIsEmpty(heap));
+}
+
+
+// Checks the AVL invariants and subtree sizes below current, returns its height
+static int _checkNode(struct AVLnode * current){
+    if(current == 0) return -1;
+    int left = _checkNode(current->left);
+    int right = _checkNode(current->right);
+    assert(current->height == 1 + (left < right ? right : left));
+    assert(left - right <= 1 && right - left <= 1);
+    assert(current->size == 1 + _sz(current->left) + _sz(current->right));
+    return current->height;
+}
+
+
+struct _Collected {
+    TYPE * values;
+    int count;
+};
+
+static int _collect(TYPE value, void * arg){
+    struct _Collected * collected = arg;
+    collected->values[collected->count++] = value;
+    return 1;
+}
+
+
+// Checks select, rank, both bounds and range against the same values sorted,
+// probing with values in the tree and values that may not be
+static void _checkQueries(struct AVLnode * root, TYPE * sorted, int count, TYPE * scratch){
+    _checkNode(root);
+    assert(_sz(root) == count);
+    for(int i = 0; i < count; i++) assert(_AVLselect(root, i)->value == sorted[i]);
+    assert(_AVLselect(root, count) == 0);
+
+    unsigned int key = 7;
+    for(int i = 0; i < 1000; i++){
+        TYPE low = _nextKey(&key);
+        if(i % 2 == 0) low = sorted[key % count];
+        TYPE high = low + (TYPE)(key % 100000);
+        int lower = _search(sorted, count, low, 0);
+        int upper = _search(sorted, count, low, 1);
+
+        assert(_AVLrank(root, low) == lower);
+        struct AVLnode * node = _AVLlowerBound(root, low);
+        assert(lower == count ? node == 0 : node != 0 && node->value == sorted[lower]);
+        node = _AVLupperBound(root, low);
+        assert(upper == count ? node == 0 : node != 0 && node->value == sorted[upper]);
+
+        struct _Collected range = { scratch, 0 };
+        int visited = _AVLrange(root, low, high, _collect, &range);
+        int end = _search(sorted, count, high, 1);
+        assert(visited == end - lower && range.count == visited);
+        assert(visited == 0 || memcmp(scratch, sorted + lower, visited * sizeof(TYPE)) == 0);
+    }
+}
 
 int main(int argc, const char * argv[]) {
-    // insert code here...
-    printf("Hello, World!\n");
+    struct AVLnode * root = 0;
+    struct AVLarena * arena = AVLarenaCreate(0);
+    TYPE * sorted = malloc(KEYS * sizeof(TYPE));
+    TYPE * scratch = malloc(KEYS * sizeof(TYPE));
+    assert(sorted != 0 && scratch != 0);
+
+    // same pseudo-random keys into both trees
+    unsigned int key = 1;
+    for(int i = 0; i < KEYS; i++){
+        sorted[i] = _nextKey(&key);
+        root = _AVLnodeAdd(root, sorted[i]);
+        AVLarenaAdd(arena, sorted[i]);
+    }
+    assert(AVLarenaSize(arena) == KEYS);
+    assert(AVLarenaHeight(arena) == _h(root) + 1);
+
+    key = 1;
+    for(int i = 0; i < KEYS; i++){
+        assert(AVLarenaContains(arena, _nextKey(&key)));
+    }
+    qsort(sorted, KEYS, sizeof(TYPE), _compare);
+    _checkQueries(root, sorted, KEYS, scratch);
+
+    printf("%d keys, height %d\n", KEYS, _h(root) + 1);
+    printf("median %d, 99th percentile %d\n", (int)_AVLselect(root, KEYS / 2)->value,
+           (int)_AVLselect(root, KEYS / 100 * 99)->value);
+    printf("pointer nodes: %zu bytes each, arena nodes: %zu bytes each\n",
+           sizeof(struct AVLnode), sizeof(struct AVLarenaNode));
+
+    // remove the keys fed in at even steps, the odd ones must be all that is left
+    key = 1;
+    int kept = 0;
+    for(int i = 0; i < KEYS; i++){
+        TYPE value = _nextKey(&key);
+        if(i % 2 == 0) root = _AVLnodeRemove(root, value);
+        else sorted[kept++] = value;
+    }
+    root = _AVLnodeRemove(root, -1);
+    qsort(sorted, kept, sizeof(TYPE), _compare);
+    _checkQueries(root, sorted, kept, scratch);
+    printf("%d keys left after removing every other one, height %d\n", _sz(root), _h(root) + 1);
+
+    // every node allocated so far was freed, the counters stay 0 without CS261_STATS
+    struct AVLstats stats;
+    _AVLfree(root);
+    _AVLstats(&stats);
+    assert(stats.allocations == stats.frees);
+
+    // a reader keeps the version it entered while the writer adds past it
+    struct AVLpersistent * versions = AVLpersistentCreate();
+    int reader = AVLpersistentJoin(versions);
+    key = 1;
+    for(int i = 0; i < KEYS / 2; i++) AVLpersistentAdd(versions, _nextKey(&key));
+    struct AVLnode * version = AVLpersistentEnter(versions, reader);
+    for(int i = KEYS / 2; i < KEYS; i++) AVLpersistentAdd(versions, _nextKey(&key));
+    _checkNode(version);
+    assert(_sz(version) == KEYS / 2);
+    key = 1;
+    for(int i = 0; i < KEYS / 2; i++) assert(_AVLfind(version, _nextKey(&key)) != 0);
+    AVLpersistentExit(versions, reader);
+
+    version = AVLpersistentEnter(versions, reader);
+    _checkNode(version);
+    assert(_sz(version) == KEYS);
+    key = 1;
+    for(int i = 0; i < KEYS; i++) assert(_AVLfind(version, _nextKey(&key)) != 0);
+    AVLpersistentExit(versions, reader);
+    AVLpersistentLeave(versions, reader);
+    AVLpersistentDestroy(versions);
+
+    // the same keys through single pushes and both batch paths, then heapify
+    key = 1;
+    for(int i = 0; i < KEYS; i++) scratch[i] = sorted[i] = _nextKey(&key);
+    qsort(sorted, KEYS, sizeof(TYPE), _compare);
+    struct DHeap * heap = dheapCreate(0);
+    dheapPushArray(heap, scratch, 100);
+    for(int i = 100; i < KEYS / 2; i++) dheapPush(heap, scratch[i]);
+    dheapPushArray(heap, scratch + KEYS / 2, KEYS / 2);
+    _checkHeap(heap, sorted, KEYS);
+    dheapHeapify(heap, scratch, KEYS);
+    _checkHeap(heap, sorted, KEYS);
+    dheapHeapify(heap, 0, 0);
+    dheapPushArray(heap, 0, 0);
+    assert(dheapIsEmpty(heap));
+    dheapDestroy(heap);
+
+    // save a tree of the same keys, then search the mapped file and rebuild
+    // each structure from it
+    const char * directory = getenv("TMPDIR");
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/avlFile%d.snapshot", directory != 0 ? directory : "/tmp", (int)getpid());
+    root = 0;
+    for(int i = 0; i < KEYS; i++) root = _AVLnodeAdd(root, scratch[i]);
+    if(AVLfileSave(root, path) != 0){
+        perror(path);
+        return 1;
+    }
+    _AVLfree(root);
+
+    struct AVLfile file;
+    if(AVLfileOpen(path, &file) != 0){
+        perror(path);
+        return 1;
+    }
+    assert(file.count == KEYS && memcmp(file.values, sorted, KEYS * sizeof(TYPE)) == 0);
+    key = 7;
+    for(int i = 0; i < 1000; i++){
+        TYPE probe = _nextKey(&key);
+        if(i % 2 == 0) probe = sorted[key % KEYS];
+        int lower = _search(sorted, KEYS, probe, 0);
+        TYPE found;
+        assert(AVLfileLowerBound(&file, probe, &found) == (lower < KEYS));
+        assert(lower == KEYS || found == sorted[lower]);
+        assert(AVLfileContains(&file, probe) == (lower < KEYS && sorted[lower] == probe));
+    }
+
+    root = AVLfileTree(&file);
+    _checkQueries(root, sorted, KEYS, scratch);
+    _AVLfree(root);
+    struct AVLarena * loaded = AVLarenaCreate(0);
+    AVLfileArena(&file, loaded);
+    assert(AVLarenaSize(loaded) == KEYS);
+    for(int i = 0; i < KEYS; i += 97) assert(AVLarenaContains(loaded, sorted[i]));
+    AVLarenaDestroy(loaded);
+    struct AVLsnapshot * snapshot = AVLfileSnapshot(&file);
+    for(int i = 0; i < KEYS; i += 97) assert(AVLsnapshotContains(snapshot, sorted[i]));
+    AVLsnapshotDestroy(snapshot);
+    AVLfileClose(&file);
+
+    // a file that is not a snapshot is turned away
+    FILE * other = fopen(path, "wb");
+    if(other == 0 || fputs("not a snapshot, but long enough to hold a header", other) < 0
+       || fclose(other) != 0){
+        perror(path);
+        return 1;
+    }
+    assert(AVLfileOpen(path, &file) == -1 && errno == EINVAL);
+    remove(path);
+    printf("snapshot file: %d keys saved and mapped back\n", KEYS);
+
+    struct AVL_f64 halves;
+    AVL_f64_init(&halves);
+    for(int i = 0; i < KEYS; i++) AVL_f64_add(&halves, i * 0.5);
+    assert(AVL_f64_contains(&halves, 0.5) && !AVL_f64_contains(&halves, 0.25));
+    printf("double tree: %d keys from %g to %g\n", AVL_f64_size(&halves),
+           AVL_f64_min(&halves), AVL_f64_max(&halves));
+    AVL_f64_cleanup(&halves);
+
+    AVLarenaDestroy(arena);
+    free(scratch);
+    free(sorted);
     return 0;
 }
@@ -0,0 +1,173 @@
+//
+//  snapshotFile.c
+//  Worksheets_AVL_Heaps
+//
+
+// open, fstat, fsync and mmap are POSIX, not C99
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snapshotFile.h"
+
+// Written as 0x01020304, reads back differently on the other byte order
+#define SNAPSHOT_BYTE_ORDER 0x01020304u
+
+// Bytes buffered per write while saving
+#define SAVE_BUFFER 8192
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t valueSize;
+    uint32_t byteOrder;
+    uint32_t reserved;
+    uint64_t count;
+};
+
+struct SnapshotWriter {
+    FILE * file;
+    size_t valueSize;
+    size_t used;
+    uint64_t count;
+    int failed;
+    char buffer[SAVE_BUFFER];
+};
+
+
+static void _fillHeader(struct SnapshotHeader * header, const struct SnapshotFormat * format, uint64_t count){
+    assert(strlen(format->magic) < sizeof(header->magic));
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, format->magic, strlen(format->magic));
+    header->version = format->version;
+    header->valueSize = format->valueSize;
+    header->byteOrder = SNAPSHOT_BYTE_ORDER;
+    header->count = count;
+}
+
+
+static void _flush(struct SnapshotWriter * writer){
+    if(fwrite(writer->buffer, 1, writer->used, writer->file) != writer->used){
+        writer->failed = 1;
+    }
+    writer->used = 0;
+}
+
+
+int snapshotWrite(struct SnapshotWriter * writer, const void * value){
+    assert(writer != 0 && value != 0);
+    if(writer->used + writer->valueSize > SAVE_BUFFER) _flush(writer);
+    memcpy(writer->buffer + writer->used, value, writer->valueSize);
+    writer->used += writer->valueSize;
+    writer->count++;
+    return !writer->failed;
+}
+
+
+int snapshotFileSave(const char * path, const struct SnapshotFormat * format,
+                     void (*walk)(struct SnapshotWriter * writer, void * arg), void * arg){
+    assert(path != 0 && format != 0 && walk != 0);
+    assert(format->valueSize > 0 && format->valueSize <= SAVE_BUFFER);
+
+    char temp[4096];
+    if(snprintf(temp, sizeof(temp), "%s.tmp", path) >= (int)sizeof(temp)){
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+
+    struct SnapshotWriter * writer = malloc(sizeof(struct SnapshotWriter));
+    assert(writer != 0);
+    writer->file = fopen(temp, "wb");
+    if(writer->file == 0){
+        free(writer);
+        return -1;
+    }
+    writer->valueSize = format->valueSize;
+    writer->used = 0;
+    writer->count = 0;
+    writer->failed = 0;
+
+    // the count is only known after the walk, so the header is written
+    // twice, once to hold its place and again once the values are out
+    struct SnapshotHeader header;
+    _fillHeader(&header, format, 0);
+
+    int failed = fwrite(&header, sizeof(header), 1, writer->file) != 1;
+    if(!failed){
+        walk(writer, arg);
+        _flush(writer);
+        _fillHeader(&header, format, writer->count);
+        failed = writer->failed || fseek(writer->file, 0, SEEK_SET) != 0
+              || fwrite(&header, sizeof(header), 1, writer->file) != 1
+              || fflush(writer->file) != 0 || fsync(fileno(writer->file)) != 0;
+    }
+    failed = fclose(writer->file) != 0 || failed;
+    free(writer);
+
+    if(failed || rename(temp, path) != 0){
+        int error = errno;
+        remove(temp);
+        errno = error;
+        return -1;
+    }
+    return 0;
+}
+
+
+int snapshotFileOpen(const char * path, const struct SnapshotFormat * format, struct SnapshotFile * file){
+    assert(path != 0 && format != 0 && file != 0);
+
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) return -1;
+    struct stat status;
+    if(fstat(fd, &status) != 0){
+        close(fd);
+        return -1;
+    }
+    size_t length = (size_t)status.st_size;
+    if(length < sizeof(struct SnapshotHeader)){
+        close(fd);
+        errno = EINVAL;
+        return -1;
+    }
+
+    void * map = mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED) return -1;
+
+    struct SnapshotHeader expected;
+    _fillHeader(&expected, format, 0);
+    const struct SnapshotHeader * header = map;
+    if(memcmp(header->magic, expected.magic, sizeof(expected.magic)) != 0
+       || header->version != expected.version
+       || header->valueSize != expected.valueSize
+       || header->byteOrder != expected.byteOrder
+       || header->count > (uint64_t)(length - sizeof(struct SnapshotHeader)) / format->valueSize
+       || header->count > INT32_MAX){
+        munmap(map, length);
+        errno = EINVAL;
+        return -1;
+    }
+
+    file->values = (const char *)map + sizeof(struct SnapshotHeader);
+    file->count = (int)header->count;
+    file->map = map;
+    file->length = length;
+    return 0;
+}
+
+
+void snapshotFileClose(struct SnapshotFile * file){
+    assert(file != 0 && file->map != 0);
+    munmap(file->map, file->length);
+    file->map = 0;
+    file->values = 0;
+    file->count = 0;
+}
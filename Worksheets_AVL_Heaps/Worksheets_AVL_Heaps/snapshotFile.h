@@ -0,0 +1,51 @@
+//
+//  snapshotFile.h
+//  Worksheets_AVL_Heaps
+//
+//  Binary snapshot files: a 32 byte header, then count values in the
+//  byte order and value size of the program that saved them. The
+//  layout is the one the CLDeque list snapshots use, so the tools that
+//  read those read these too. avlFile.c supplies the format and the
+//  walk that writes the values out.
+//
+
+#ifndef snapshotFile_h
+#define snapshotFile_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct SnapshotFormat {
+    const char * magic;     // at most 7 characters
+    uint32_t version;
+    uint32_t valueSize;
+};
+
+// Snapshot file mapped read-only, values[0 .. count-1] can be read in
+// place until the file is closed
+struct SnapshotFile {
+    const void * values;
+    int count;
+    void * map;
+    size_t length;
+};
+
+// Buffers values on their way to the file during snapshotFileSave
+struct SnapshotWriter;
+
+// Writes and syncs the file under path.tmp, then renames it over path,
+// so after a crash path holds the old snapshot or the new one. The walk
+// calls snapshotWrite once per value, in order; snapshotWrite returns 0
+// once a write has failed so the walk can stop early. Returns 0, or -1
+// with errno set.
+int snapshotFileSave(const char * path, const struct SnapshotFormat * format,
+                     void (*walk)(struct SnapshotWriter * writer, void * arg), void * arg);
+int snapshotWrite(struct SnapshotWriter * writer, const void * value);
+
+// Maps the file and checks its magic, version, value size and byte
+// order. Returns 0, or -1 with errno set, EINVAL if the file is not a
+// usable snapshot.
+int snapshotFileOpen(const char * path, const struct SnapshotFormat * format, struct SnapshotFile * file);
+void snapshotFileClose(struct SnapshotFile * file);
+
+#endif /* snapshotFile_h */
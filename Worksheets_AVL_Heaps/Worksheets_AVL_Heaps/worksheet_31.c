@@ -6,14 +6,39 @@
 //  Copyright © 2017 Romano Garza. All rights reserved.
 //
 
+#include <string.h>
 #include "worksheet_31.h"
 
+// Instrumentation counters, compiled out unless CS261_STATS is defined.
+// The tree functions take bare nodes, so the counters are kept per thread
+// rather than per tree.
+#ifdef CS261_STATS
+static _Thread_local struct AVLstats _stats;
+#define STAT_ADD(counter, n) (_stats.counter += (n))
+#define STAT_MAX(counter, value) \
+    do { if((value) > _stats.counter) _stats.counter = (value); } while(0)
+#else
+#define STAT_ADD(counter, n) ((void)0)
+#define STAT_MAX(counter, value) ((void)0)
+#endif
+
 int _h(struct AVLnode * current){
     if (current == 0) return -1;
     return current->height;
 }
 
 
+int _sz(struct AVLnode * current){
+    if (current == 0) return 0;
+    return current->size;
+}
+
+
+void _setSize(struct AVLnode * current){
+    current->size = 1 + _sz(current->left) + _sz(current->right);
+}
+
+
 void _setHeight (struct AVLnode * current) {
     int lch = _h(current->left);
     int rch = _h(current->right);
@@ -22,20 +47,69 @@ void _setHeight (struct AVLnode * current) {
 }
 
 
+static struct AVLnode * _newNode(TYPE newValue){
+    struct AVLnode * newnode = (struct AVLnode*) malloc(sizeof(struct AVLnode));
+    assert(newnode!=0);
+    STAT_ADD(allocations, 1);
+    newnode->value = newValue;
+    newnode->left =newnode ->right = 0;
+    newnode->height = 0;
+    newnode->size = 1;
+    return newnode;
+}
+
+
+// Walks down keeping the links it passed on a stack, then rebalances on the
+// way back up. Once a subtree comes back at the height it had before, nothing
+// above it can change, so the climb stops there.
 struct AVLnode * _AVLnodeAdd (struct AVLnode* current, TYPE newValue){
-    struct AVLnode * newnode;
-    if(current == 0){
-        newnode = (struct AVLnode*) malloc(sizeof(struct AVLnode));
-        assert(newnode!=0);
-        newnode->value = newValue;
-        newnode->left =newnode ->right = 0;
-        return newnode;
+    struct AVLnode ** path[AVL_MAX_HEIGHT];
+    int depth = 0;
+    struct AVLnode ** link = &current;
+    while(*link != 0){
+        assert(depth < AVL_MAX_HEIGHT);
+        path[depth++] = link;
+        STAT_ADD(traversed, 1);
+        // every node passed gains one, whether or not the climb reaches it
+        (*link)->size++;
+        if(newValue < (*link)->value) link = &(*link)->left;
+        else link = &(*link)->right;
     }
-    else if(newValue < current->value){
-        current->left = _AVLnodeAdd(current->left, newValue);
+    *link = _newNode(newValue);
+
+    while(depth > 0){
+        link = path[--depth];
+        int oldHeight = (*link)->height;
+        *link = _balance(*link);
+        if((*link)->height == oldHeight) break;
     }
-    else current->right = _AVLnodeAdd(current->right, newValue);
-    return _balance(current);
+    STAT_MAX(maxHeight, current->height + 1);
+    STAT_MAX(peakSize, current->size);
+    return current;
+}
+
+
+static struct AVLnode * _buildRange(TYPE * values, int low, int high){
+    if(low > high) return 0;
+    int mid = low + (high - low) / 2;
+    struct AVLnode * current = _newNode(values[mid]);
+    current->left = _buildRange(values, low, mid - 1);
+    current->right = _buildRange(values, mid + 1, high);
+    _setHeight(current);
+    _setSize(current);
+    return current;
+}
+
+
+// O(n): the middle value becomes the root and each half becomes a subtree,
+// so the two sides never differ in height by more than one
+struct AVLnode * _AVLbuildSorted(TYPE * values, int count){
+    assert(count == 0 || values != 0);
+    for(int i = 1; i < count; i++) assert(!(values[i] < values[i - 1]));
+    struct AVLnode * root = _buildRange(values, 0, count - 1);
+    STAT_MAX(maxHeight, _h(root) + 1);
+    STAT_MAX(peakSize, count);
+    return root;
 }
 
 
@@ -48,12 +122,14 @@ struct AVLnode * _balance(struct AVLnode * current){
     int cbf = _bf(current);
     if(cbf < -1){
         if(_bf(current->left) > 0) {
+            STAT_ADD(rotateLeftRight, 1);
             current->left = _rotateLeft(current->left);
         }
         return _rotateRight(current);
     }
     else if (cbf > 1) {
-        if (_bf(current->left) > 0){
+        if (_bf(current->right) < 0){
+            STAT_ADD(rotateRightLeft, 1);
             current->right = _rotateRight(current->right);
         }
         return _rotateLeft(current);
@@ -68,6 +144,7 @@ struct AVLnode * _rotateLeft(struct AVLnode * current){
  
 // Set new top node to the current node's right child
     struct AVLnode * newTop = current->right;
+    STAT_ADD(rotateLeft, 1);
 // Set current nodes new right child to the new top nodes _left_ child
     current->right = newTop->left;
 // Set new top's left child to current node
@@ -75,16 +152,19 @@ struct AVLnode * _rotateLeft(struct AVLnode * current){
 // Set height of current node and new top node
     _setHeight(current);
     _setHeight(newTop);
+    _setSize(current);
+    _setSize(newTop);
 // Return new top node
     return newTop;
 }
 
 
  
-struct AVLnode * _rotaterRight(struct AVLnode * current){
+struct AVLnode * _rotateRight(struct AVLnode * current){
  
  // Set new top node to the current node's left child
     struct AVLnode * newTop = current->left; 
+    STAT_ADD(rotateRight, 1);
  // Set current nodes new left child to the new top nodes _right_ child
     current->left = newTop->right;
  // Set new top's right child to current node
@@ -92,8 +172,202 @@ struct AVLnode * _rotaterRight(struct AVLnode * current){
  // Set height of current node and new top node
     _setHeight(current);
     _setHeight(newTop);
+    _setSize(current);
+    _setSize(newTop);
  // Return new top node
     return newTop;
 }
  
 
+
+struct AVLnode * _AVLfind(struct AVLnode * current, TYPE value){
+    while(current != 0){
+        STAT_ADD(traversed, 1);
+        if(value < current->value) current = current->left;
+        else if(current->value < value) current = current->right;
+        else return current;
+    }
+    return 0;
+}
+
+
+// Removes one node holding value, if there is one. A node with two children
+// takes its in-order successor's value and the successor is unlinked instead.
+// Heights stop changing at the same point as in _AVLnodeAdd, but every node on
+// the path still loses one from its size.
+struct AVLnode * _AVLnodeRemove(struct AVLnode * current, TYPE value){
+    struct AVLnode ** path[AVL_MAX_HEIGHT];
+    int depth = 0;
+    struct AVLnode ** link = &current;
+    while(*link != 0 && ((*link)->value < value || value < (*link)->value)){
+        assert(depth < AVL_MAX_HEIGHT);
+        STAT_ADD(traversed, 1);
+        path[depth++] = link;
+        if(value < (*link)->value) link = &(*link)->left;
+        else link = &(*link)->right;
+    }
+    if(*link == 0) return current;
+
+    struct AVLnode * target = *link;
+    if(target->left != 0 && target->right != 0){
+        path[depth++] = link;
+        link = &target->right;
+        while((*link)->left != 0){
+            assert(depth < AVL_MAX_HEIGHT);
+            STAT_ADD(traversed, 1);
+            path[depth++] = link;
+            link = &(*link)->left;
+        }
+        target->value = (*link)->value;
+    }
+
+    struct AVLnode * gone = *link;
+    *link = gone->left != 0 ? gone->left : gone->right;
+    free(gone);
+    STAT_ADD(frees, 1);
+
+    int settled = 0;
+    while(depth > 0){
+        link = path[--depth];
+        (*link)->size--;
+        if(!settled){
+            int oldHeight = (*link)->height;
+            *link = _balance(*link);
+            settled = (*link)->height == oldHeight;
+        }
+    }
+    return current;
+}
+
+
+// First node whose value is not less than value, or 0
+struct AVLnode * _AVLlowerBound(struct AVLnode * current, TYPE value){
+    struct AVLnode * found = 0;
+    while(current != 0){
+        STAT_ADD(traversed, 1);
+        if(current->value < value) current = current->right;
+        else {
+            found = current;
+            current = current->left;
+        }
+    }
+    return found;
+}
+
+
+// First node whose value is greater than value, or 0
+struct AVLnode * _AVLupperBound(struct AVLnode * current, TYPE value){
+    struct AVLnode * found = 0;
+    while(current != 0){
+        STAT_ADD(traversed, 1);
+        if(value < current->value){
+            found = current;
+            current = current->left;
+        }
+        else current = current->right;
+    }
+    return found;
+}
+
+
+// Calls visit on every value in [low, high] in order until visit returns 0,
+// returns how many values were visited. The stack holds the nodes not below
+// low whose left subtrees are done, so it never grows past the tree height.
+int _AVLrange(struct AVLnode * current, TYPE low, TYPE high,
+              int (*visit)(TYPE value, void * arg), void * arg){
+    assert(visit != 0);
+    struct AVLnode * stack[AVL_MAX_HEIGHT];
+    int depth = 0, visited = 0;
+
+    while(current != 0){
+        STAT_ADD(traversed, 1);
+        if(current->value < low) current = current->right;
+        else {
+            stack[depth++] = current;
+            current = current->left;
+        }
+    }
+    while(depth > 0){
+        current = stack[--depth];
+        if(high < current->value) break;
+        visited++;
+        if(!visit(current->value, arg)) break;
+        for(current = current->right; current != 0; current = current->left){
+            STAT_ADD(traversed, 1);
+            stack[depth++] = current;
+        }
+    }
+    return visited;
+}
+
+
+// Number of values less than value
+int _AVLrank(struct AVLnode * current, TYPE value){
+    int rank = 0;
+    while(current != 0){
+        STAT_ADD(traversed, 1);
+        if(current->value < value){
+            rank += _sz(current->left) + 1;
+            current = current->right;
+        }
+        else current = current->left;
+    }
+    return rank;
+}
+
+
+// Node holding the k-th smallest value counting from 0, or 0 if there are
+// not that many values
+struct AVLnode * _AVLselect(struct AVLnode * current, int k){
+    if(k < 0 || k >= _sz(current)) return 0;
+    while(current != 0){
+        STAT_ADD(traversed, 1);
+        int left = _sz(current->left);
+        if(k < left) current = current->left;
+        else if(k > left){
+            k -= left + 1;
+            current = current->right;
+        }
+        else return current;
+    }
+    return 0;
+}
+
+
+void _AVLfree(struct AVLnode * current){
+    if(current == 0) return;
+    _AVLfree(current->left);
+    _AVLfree(current->right);
+    free(current);
+    STAT_ADD(frees, 1);
+}
+
+
+// Copies the calling thread's counters, all 0 unless built with CS261_STATS
+void _AVLstats(struct AVLstats * stats){
+    assert(stats != 0);
+#ifdef CS261_STATS
+    *stats = _stats;
+#else
+    memset(stats, 0, sizeof(struct AVLstats));
+#endif
+}
+
+
+void _AVLstatsReset(void){
+#ifdef CS261_STATS
+    memset(&_stats, 0, sizeof(struct AVLstats));
+#endif
+}
+
+
+// Prints the calling thread's counters as one line of JSON
+void _AVLstatsPrint(void){
+    struct AVLstats stats;
+    _AVLstats(&stats);
+    printf("{\"structure\": \"AVL\", \"allocations\": %lu, \"frees\": %lu, \"traversed\": %lu, "
+           "\"rotate_left\": %lu, \"rotate_right\": %lu, \"rotate_left_right\": %lu, "
+           "\"rotate_right_left\": %lu, \"max_height\": %d, \"peak_size\": %d}\n",
+           stats.allocations, stats.frees, stats.traversed, stats.rotateLeft, stats.rotateRight,
+           stats.rotateLeftRight, stats.rotateRightLeft, stats.maxHeight, stats.peakSize);
+}
@@ -17,19 +17,60 @@
 #include <assert.h>
 #include <stdio.h>
 
+// Deeper than any AVL tree that fits in memory (height < 1.45 log2 n)
+#ifndef AVL_MAX_HEIGHT
+#define AVL_MAX_HEIGHT 64
+#endif
+
 struct AVLnode {
     TYPE value;
     struct AVLnode *left;
     struct AVLnode *right;
     int height;
+    int size;       // nodes in this subtree, for rank and select
 };
 
 int _h(struct AVLnode * current);
 void _setHeight(struct AVLnode * current);
 struct AVLnode * _AVLnodeAdd(struct AVLnode* current, TYPE newValue);
+struct AVLnode * _AVLbuildSorted(TYPE * values, int count);
 int _bf (struct AVLnode * current);
 struct AVLnode * _balance(struct AVLnode * current);
 struct AVLnode * _rotateLeft(struct AVLnode * current);
 struct AVLnode * _rotateRight(struct AVLnode * current);
 
+// Ordered set interface, equal values are kept and found in any order
+
+int _sz(struct AVLnode * current);
+void _setSize(struct AVLnode * current);
+struct AVLnode * _AVLfind(struct AVLnode * current, TYPE value);
+struct AVLnode * _AVLnodeRemove(struct AVLnode * current, TYPE value);
+struct AVLnode * _AVLlowerBound(struct AVLnode * current, TYPE value);
+struct AVLnode * _AVLupperBound(struct AVLnode * current, TYPE value);
+int _AVLrange(struct AVLnode * current, TYPE low, TYPE high,
+              int (*visit)(TYPE value, void * arg), void * arg);
+int _AVLrank(struct AVLnode * current, TYPE value);
+struct AVLnode * _AVLselect(struct AVLnode * current, int k);
+void _AVLfree(struct AVLnode * current);
+
+// Instrumentation, the counters only move when built with CS261_STATS.
+// rotateLeft and rotateRight count every single rotation, a double
+// rotation also counts as one of rotateLeftRight or rotateRightLeft.
+
+struct AVLstats {
+    unsigned long allocations;
+    unsigned long frees;
+    unsigned long traversed;    // nodes visited by searches and updates
+    unsigned long rotateLeft;
+    unsigned long rotateRight;
+    unsigned long rotateLeftRight;
+    unsigned long rotateRightLeft;
+    int maxHeight;              // levels, a single node is 1
+    int peakSize;
+};
+
+void _AVLstats(struct AVLstats * stats);
+void _AVLstatsReset(void);
+void _AVLstatsPrint(void);
+
 #endif /* worksheet_31_h */